@@ -0,0 +1,36 @@
+#!/bin/bash
+# 对比当前的little_lexer与由little_lexer.l重新生成的词法分析器的速度
+# 用法: ./bench.sh [旧的little_lexer [重复次数]]
+# 把sealpps/中的文件重复拼接成一个大文件，两个程序各运行三次取最快的一次，
+# 并检查两者输出完全一致。
+old=${1:-./little_lexer}
+times=${2:-20000}
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+if command -v flex > /dev/null; then
+    flex -o $tmp/lex.yy.c ./little_lexer.l || exit 1
+else
+    python3 ./mklexer.py lex.yy.c little_lexer.l $tmp/lex.yy.c > /dev/null || exit 1
+fi
+gcc -O2 $tmp/lex.yy.c -lfl -o $tmp/little_lexer || exit 1
+
+for ((i = 0; i < times; i++)); do cat sealpps/*.sealpp; done > $tmp/input.sealpp
+bytes=$(stat -c %s $tmp/input.sealpp)
+
+run() {
+    best=
+    for i in 1 2 3; do
+        start=$(date +%s.%N)
+        $1 < $tmp/input.sealpp > $2
+        end=$(date +%s.%N)
+        best=$(awk -v s=$start -v e=$end -v b="$best" \
+            'BEGIN { t = e - s; if (b != "" && b < t) t = b; print t }')
+    done
+    awk -v n=$bytes -v t=$best -v w="$3" \
+        'BEGIN { printf "%-16s %d bytes %8.3f s %8.1f MB/s\n", w, n, t, n / t / 1e6 }'
+}
+
+run $old $tmp/old.out "$old"
+run $tmp/little_lexer $tmp/new.out "little_lexer.l"
+cmp -s $tmp/old.out $tmp/new.out && echo "outputs identical" || { echo "outputs differ"; exit 1; }
@@ -1,2 +1,3 @@
-flex ./little_lexer.l
+# 没有flex时由mklexer.py在lex.yy.c上重新生成
+if command -v flex > /dev/null; then flex ./little_lexer.l; else python3 ./mklexer.py; fi
 gcc ./lex.yy.c -lfl -o little_lexer
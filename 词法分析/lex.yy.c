@@ -3,7 +3,9 @@
 
 #define  YY_INT_ALIGNED short int
 
-/* A lexical scanner generated by flex */
+/* A lexical scanner in the form flex 2.6.4 generates: mklexer.py wrote
+   the tables and actions for little_lexer.l into this skeleton.  With
+   flex installed, flex little_lexer.l gives an equivalent scanner. */
 
 #define FLEX_SCANNER
 #define YY_FLEX_MAJOR_VERSION 2
@@ -351,8 +353,8 @@ static void yynoreturn yy_fatal_error ( const char* msg  );
 	(yy_hold_char) = *yy_cp; \
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
-#define YY_NUM_RULES 13
-#define YY_END_OF_BUFFER 14
+#define YY_NUM_RULES 16
+#define YY_END_OF_BUFFER 17
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -360,55 +362,22 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_acclist[230] =
+static const flex_int16_t yy_accept[126] =
     {   0,
-       14,   13,    1,   13,    4,   13,    5,   13,   12,   13,
-        9,   13,    9,   13,    9,   13,    9,   13,   11,   13,
-       13,    9,   13,   13,    9,   13,   13,   13,   13,   13,
-       13,    8,   13,    8,   13,    8,   13,    8,   13,    8,
-       13,    8,   13,    8,   13,    8,   13,    8,   13,    9,
-       13,    2,    5,   13,    2,   12,   13,    2,    9,   13,
-        2,    9,   13,    2,    9,   13,    2,    9,   13,    2,
-       11,   13,   13,    2,    9,   13,   13,    2,    9,   13,
-       13,   13,   13,   13,   13,    2,    8,   13,    2,    8,
-       13,    2,    8,   13,    2,    8,   13,    2,    8,   13,
-
-        2,    8,   13,    2,    8,   13,    2,    8,   13,    2,
-        8,   13,    2,    9,   13,    3,    4,    9,   11,    9,
-        8,    8,    8,    8,    8,    8,    8,    7,    8,    8,
-        8,    2,    9,    2,   11,    2,    9,    2,    8,    2,
-        8,    2,    8,    2,    8,    2,    8,    2,    8,    2,
-        8,    2,    7,    8,    2,    8,    2,    8,   11,    6,
-        8,    8,    8,    8,    8,    8,    8,    8,    2,   11,
-        2,    6,    2,    8,    2,    8,    2,    8,    2,    8,
-        2,    8,    2,    8,    2,    8,    2,    8,    8,    8,
-        8,    8,    8,    8,    8,    2,    8,    2,    8,    2,
-
-        8,    2,    8,    2,    8,    2,    8,    2,    8,    8,
-        8,    8,    2,    8,    2,    8,    2,    8,    8,    8,
-       10,    2,    8,    2,    8,    8,   10,    2,    8
-    } ;
-
-static const flex_int16_t yy_accept[168] =
-    {   0,
-        1,    1,    1,    2,    3,    5,    7,    9,   11,   13,
-       15,   17,   19,   21,   22,   24,   25,   27,   28,   29,
-       30,   31,   32,   34,   36,   38,   40,   42,   44,   46,
-       48,   50,   52,   55,   58,   61,   64,   67,   70,   73,
-       74,   77,   78,   81,   82,   83,   84,   85,   86,   89,
-       92,   95,   98,  101,  104,  107,  110,  113,  116,  117,
-      118,  119,  119,  119,  120,  121,  121,  121,  121,  121,
-      121,  122,  123,  124,  125,  126,  127,  128,  130,  131,
-      132,  134,  134,  134,  136,  138,  138,  138,  138,  138,
-      138,  140,  142,  144,  146,  148,  150,  152,  155,  157,
-
-      159,  159,  160,  160,  160,  161,  161,  161,  162,  163,
-      164,  165,  166,  167,  168,  169,  169,  171,  171,  171,
-      173,  173,  173,  175,  177,  179,  181,  183,  185,  187,
-      189,  189,  189,  190,  191,  192,  193,  194,  195,  196,
-      196,  196,  198,  200,  202,  204,  206,  208,  210,  210,
-      211,  212,  212,  213,  213,  215,  217,  219,  220,  221,
-      222,  224,  226,  227,  228,  230,  230
+        0,    0,    0,    0,   17,   16,    1,    3,    4,   11,
+        8,    8,    8,    8,    8,    8,    4,    8,    8,   10,
+       16,    8,    8,   16,    8,   16,   16,   16,   16,   16,
+        8,    7,    7,    7,    7,    7,    7,    7,    7,    7,
+        8,    8,    8,    8,   12,   15,   14,    2,    3,    8,
+        0,    8,    8,    0,   10,    8,    8,    8,    8,    0,
+        0,    0,    0,    0,    7,    7,    7,    7,    7,    7,
+        7,    6,    7,    7,    8,   12,   13,   14,    0,   10,
+        0,    0,    5,    0,    0,    7,    7,    7,    7,    7,
+        7,    7,    7,    8,    5,    0,    0,    5,    7,    7,
+
+        7,    6,    7,    7,    7,    7,    5,    0,    6,    6,
+        7,    7,    0,    7,    6,    5,    7,    7,    9,    6,
+        7,    6,    9,    6,    0
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -445,150 +414,152 @@ static const YY_CHAR yy_ec[256] =
 
 static const YY_CHAR yy_meta[53] =
     {   0,
-        1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    3,    1,    1,    1,    1,
-        1,    3,    3,    3,    3,    3,    3,    1,    4,    4,
-        4,    4,    4,    4,    4,    4,    4,    4,    4,    4,
-        4,    4,    4,    4,    4,    4,    4,    4,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1
     } ;
 
-static const flex_int16_t yy_base[171] =
+static const flex_int16_t yy_base[126] =
     {   0,
-        0,   52,  262,  263,  263,  103,  263,  263,   73,  254,
-      263,  263,   94,  240,  239,  238,  237,  214,  215,  213,
-      207,  210,  222,  206,  207,    0,  208,   68,  213,  213,
-      209,  194,  263,  263,   80,  236,  263,  263,  103,  222,
-      221,  220,  219,  196,  197,  195,  189,  192,  204,  188,
-      189,    0,  190,   69,  195,  195,  191,  176,  263,  119,
-      263,  185,  208,  110,  263,  181,  180,  175,  176,  182,
-        0,  184,  184,  175,  170,  170,  172,    0,  166,  174,
-      263,  170,  193,  113,  263,  166,  165,  160,  161,  167,
-        0,  169,  169,  160,  155,  155,  157,    0,  151,  159,
-
-      163,  178,  153,  163,  263,  154,  158,  147,  159,  141,
-      153,  148,  153,  136,  142,  149,  164,  139,  149,  263,
-      140,  144,  133,  145,  127,  139,  134,  139,  122,  128,
-      121,  125,  121,  125,  126,  121,  158,  116,  126,  112,
-      116,  112,  116,  117,  112,  149,  107,  117,  114,  107,
-      101,  143,  104,  109,  102,   96,  100,   93,  105,    0,
-       88,   94,   90,    0,   76,  263,  127,  129,  132,  134
+        0,    0,   52,    0,  332,  332,  332,  103,  332,  332,
+       73,  101,  332,  332,  332,  332,  332,  332,  332,   95,
+       90,  332,   92,   94,   95,   74,   77,   78,   74,   79,
+      332,  106,  126,  127,   94,   84,  114,   91,   93,   91,
+      332,   84,  332,  332,  167,  332,  156,  332,    0,  332,
+      120,  332,  332,  146,    0,  332,  332,  332,  332,  121,
+      122,  119,  122,  130,    0,  186,  188,  181,  178,  180,
+      184,    0,  180,  190,  332,    0,  332,    0,  196,    0,
+      189,  201,  332,  194,  200,  191,  205,  189,  203,  200,
+      207,  192,  200,  332,  332,  195,  201,  332,  199,  205,
+
+      208,    0,  205,  244,  204,  216,  332,  215,    0,    0,
+      210,  206,  250,  213,    0,  332,  208,  222,  283,    0,
+      224,    0,    0,    0,  332
     } ;
 
-static const flex_int16_t yy_def[171] =
+static const flex_int16_t yy_def[126] =
     {   0,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  167,  167,  167,  167,  167,  167,  167,  167,
-      167,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  168,  168,
-      168,  168,  168,  168,  168,  168,  168,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      167,  167,  167,  167,  167,  167,  167,  167,  167,  167,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      168,  168,  168,  168,  168,  168,  168,  168,  168,  168,
-
-      166,  166,  166,  166,  166,  166,  166,  167,  167,  167,
-      167,  167,  167,  167,  167,  166,  166,  166,  166,  166,
-      166,  166,  168,  168,  168,  168,  168,  168,  168,  168,
-      166,  166,  167,  167,  167,  167,  167,  167,  167,  166,
-      166,  168,  168,  168,  168,  168,  168,  168,  166,  167,
-      167,  169,  167,  166,  168,  168,  168,  167,  167,  170,
-      168,  168,  167,  170,  168,    0,  166,  166,  166,  166
+      125,    1,  125,    3,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,   32,   32,   32,   35,   35,   35,   35,   35,
+      125,  125,  125,  125,  125,  125,  125,  125,    8,  125,
+      125,  125,  125,  125,   20,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,   35,   35,   35,   35,   35,   33,
+       35,   35,   35,   35,  125,   45,  125,   47,  125,   54,
+      125,  125,  125,  125,  125,   34,   32,   35,   35,   35,
+       35,   35,   35,  125,  125,  125,  125,  125,   33,   35,
+
+       35,   35,   35,   35,   33,   35,  125,  125,   35,   35,
+       35,   35,  125,   35,   35,  125,   35,   35,  125,   35,
+       35,   35,  119,   35,    0
     } ;
 
-static const flex_int16_t yy_nxt[316] =
+static const flex_int16_t yy_nxt[385] =
     {   0,
-        4,    5,    6,    7,    8,    9,   10,   11,   11,   11,
-       11,    7,   12,    4,   11,   13,   14,   11,   15,   16,
-       17,    4,   18,   19,   20,   21,   22,   11,   23,   24,
-       25,   26,   27,   28,   26,   26,   29,   26,   26,   26,
-       26,   26,   26,   30,   26,   26,   26,   31,   11,   32,
-       11,   11,    4,    5,    6,   33,   34,   35,   36,   37,
-       37,   37,   37,   33,   38,    4,   37,   39,   40,   37,
-       41,   42,   43,    4,   44,   45,   46,   47,   48,   37,
-       49,   50,   51,   52,   53,   54,   52,   52,   55,   52,
-       52,   52,   52,   52,   52,   56,   52,   52,   52,   57,
-
-       37,   58,   37,   37,   59,   60,   61,   63,   98,   64,
-       76,   96,   62,   81,   77,   97,   83,   61,   84,   82,
-       59,   60,   78,   63,   81,   64,   83,   98,   84,   71,
-       71,   91,   91,  160,  165,  160,  164,  164,   78,  163,
-       98,  162,  161,  120,   78,  152,  159,  158,  105,   98,
-      157,  152,  156,  155,   98,   98,  154,  120,   78,  153,
-      152,  151,  150,   78,   78,  149,  105,  148,  147,  146,
-      145,   98,  144,  143,  142,  120,  141,  140,  120,  117,
-       81,  139,  138,  137,  136,   78,  135,  134,  133,  105,
-      132,  131,  105,  102,   61,  130,  129,  128,  127,  126,
-
-      125,  124,  123,  122,  121,  120,  119,  118,  117,  116,
-      115,  114,  113,  112,  111,  110,  109,  108,  107,  106,
-      105,  104,  103,  102,  101,   81,  100,   99,   98,   95,
-       94,   93,   92,   90,   89,   88,   87,   86,   85,   85,
-       85,   81,   81,   61,   80,   79,   78,   75,   74,   73,
-       72,   70,   69,   68,   67,   66,   65,   65,   65,   61,
-       61,  166,    3,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166
+        6,    7,    8,    9,   10,   11,   12,   13,   14,   15,
+       16,   17,   18,    6,   19,   20,   21,   22,   23,   24,
+       25,    6,   26,   27,   28,   29,   30,   31,   32,   33,
+       34,   35,   36,   37,   35,   35,   38,   35,   35,   35,
+       35,   35,   35,   39,   35,   35,   35,   40,   41,   42,
+       43,   44,   45,   46,   47,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+
+       45,   45,   45,   45,   48,   49,   50,   53,   54,   56,
+       55,   57,   51,   58,   59,   60,   61,   52,   62,   63,
+       64,   65,   65,   69,   72,   73,   74,   65,   65,   65,
+       65,   65,   65,   75,   66,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   65,   65,   65,   65,
+       65,   65,   65,   65,   65,   65,   70,   77,   78,   79,
+       71,   80,   81,   82,   83,   84,   85,   76,   68,   67,
+       76,   76,   76,   76,   76,   76,   76,   76,   76,   76,
+       76,   76,   76,   76,   76,   76,   76,   76,   76,   76,
+       76,   76,   76,   76,   76,   76,   76,   76,   76,   76,
+
+       76,   76,   76,   76,   76,   76,   76,   76,   76,   76,
+       76,   76,   76,   76,   76,   76,   76,   76,   76,   86,
+       87,   88,   89,   90,   91,   92,   93,   94,   95,   96,
+       97,   98,   99,  100,  101,  102,  103,  104,  105,  106,
+      107,  108,  109,  110,  111,  112,  113,  114,  115,  116,
+      117,  118,  113,  120,  121,  122,  124,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  119,  119,
+      119,  119,  119,  119,  119,  119,  119,  119,  119,  119,
+      119,  119,  119,  119,  119,  119,  119,  119,  123,    0,
+
+        0,    0,    0,    0,  123,  123,  123,  123,  123,  123,
+        0,  123,  123,  123,  123,  123,  123,  123,  123,  123,
+      123,  123,  123,  123,  123,  123,  123,  123,  123,  123,
+      123,    5,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125
     } ;
 
-static const flex_int16_t yy_chk[316] =
+static const flex_int16_t yy_chk[385] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-
-        2,    2,    2,    2,    6,    6,    9,   13,  165,   13,
-       28,   54,    9,   35,   28,   54,   39,    9,   39,   35,
-       60,   60,  163,   64,   35,   64,   84,  162,   84,  167,
-      167,  168,  168,  169,  161,  169,  170,  170,  159,  158,
-      157,  156,  155,  154,  153,  152,  151,  150,  149,  148,
-      147,  146,  145,  144,  143,  142,  141,  140,  139,  138,
-      137,  136,  135,  134,  133,  132,  131,  130,  129,  128,
-      127,  126,  125,  124,  123,  122,  121,  119,  118,  117,
-      116,  115,  114,  113,  112,  111,  110,  109,  108,  107,
-      106,  104,  103,  102,  101,  100,   99,   97,   96,   95,
-
-       94,   93,   92,   90,   89,   88,   87,   86,   83,   82,
-       80,   79,   77,   76,   75,   74,   73,   72,   70,   69,
-       68,   67,   66,   63,   62,   58,   57,   56,   55,   53,
-       51,   50,   49,   48,   47,   46,   45,   44,   43,   42,
-       41,   40,   36,   32,   31,   30,   29,   27,   25,   24,
-       23,   22,   21,   20,   19,   18,   17,   16,   15,   14,
-       10,    3,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-
-      166,  166,  166,  166,  166,  166,  166,  166,  166,  166,
-      166,  166,  166,  166,  166
+        1,    1,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+        3,    3,    3,    3,    3,    3,    3,    3,    3,    3,
+
+        3,    3,    3,    3,    8,    8,   11,   12,   20,   21,
+       20,   23,   11,   24,   25,   26,   27,   11,   28,   29,
+       30,   32,   35,   36,   38,   39,   40,   32,   32,   32,
+       32,   32,   32,   42,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   32,   32,   32,   32,   32,   32,
+       32,   32,   32,   32,   33,   34,   37,   47,   47,   51,
+       37,   54,   60,   61,   62,   63,   64,   45,   34,   33,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
+       45,   45,   45,   45,   45,   45,   45,   45,   45,   66,
+       67,   68,   69,   70,   71,   73,   74,   79,   81,   82,
+       84,   85,   86,   87,   88,   89,   90,   91,   92,   93,
+       96,   97,   99,  100,  101,  103,  104,  105,  106,  108,
+      111,  112,  113,  114,  117,  118,  121,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  113,  113,
+      113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+      113,  113,  113,  113,  113,  113,  113,  113,  119,    0,
+
+        0,    0,    0,    0,  119,  119,  119,  119,  119,  119,
+        0,  119,  119,  119,  119,  119,  119,  119,  119,  119,
+      119,  119,  119,  119,  119,  119,  119,  119,  119,  119,
+      119,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125,  125,  125,  125,  125,  125,  125,
+      125,  125,  125,  125
     } ;
 
+static yy_state_type yy_last_accepting_state;
+static char *yy_last_accepting_cpos;
+
 extern int yy_flex_debug;
 int yy_flex_debug = 0;
 
-static yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
-static char *yy_full_match;
-static int yy_lp;
-#define REJECT \
-{ \
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */ \
-yy_cp = (yy_full_match); /* restore poss. backed-over text */ \
-++(yy_lp); \
-goto find_rule; \
-}
-
+/* The intent behind this definition is that it'll catch
+ * any uses of REJECT which flex missed.
+ */
+#define REJECT reject_used_but_not_detected
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
@@ -601,13 +572,26 @@ char *yytext;
     int count=0;//字符数
     int nWord =0;//单词数
     int nRow=0;//行数
-#line 605 "lex.yy.c"
+
+    /*
+     * 行首的单词前面没有空格，由单词自己计数。at_bol记录下一个记号是否
+     * 位于行首，line_start记录当前记号是否位于行首；每条规则的动作之前
+     * 由YY_USER_ACTION更新，这样不需要REJECT，扫描器只走一遍DFA。
+     */
+    int at_bol=1;
+    int line_start;
+    #define YY_USER_ACTION \
+        line_start=at_bol; \
+        at_bol=(yytext[yyleng-1]=='\n');
+#line 587 "lex.yy.c"
 /*定义（Definitions）*/
 /*NUM [-]?[0-9]+(\.[0-9]+)?*/
+/*注释：#到行尾，在COMMENT状态中按空格分段匹配*/
 /*规则（Rules）*/
-#line 609 "lex.yy.c"
+#line 592 "lex.yy.c"
 
 #define INITIAL 0
+#define COMMENT 1
 
 #ifndef YY_NO_UNISTD_H
 /* Special case for "unistd.h", since it is non-ANSI. We include it way
@@ -785,9 +769,6 @@ extern int yylex (void);
 #endif
 
 #define YY_RULE_SETUP \
-	if ( yyleng > 0 ) \
-		YY_CURRENT_BUFFER_LVALUE->yy_at_bol = \
-				(yytext[yyleng - 1] == '\n'); \
 	YY_USER_ACTION
 
 /** The main scanner function which does all the work.
@@ -806,12 +787,6 @@ YY_DECL
 		YY_USER_INIT;
 #endif
 
-        /* Create the reject buffer large enough to save one state per allowed character. */
-        if ( ! (yy_state_buf) )
-            (yy_state_buf) = (yy_state_type *)yyalloc(YY_STATE_BUF_SIZE  );
-            if ( ! (yy_state_buf) )
-                YY_FATAL_ERROR( "out of dynamic memory in yylex()" );
-
 		if ( ! (yy_start) )
 			(yy_start) = 1;	/* first start state */
 
@@ -831,10 +806,10 @@ YY_DECL
 		}
 
 	{
-#line 23 "./little_lexer.l"
+#line 38 "./little_lexer.l"
 
 
-#line 838 "lex.yy.c"
+#line 813 "lex.yy.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -849,46 +824,34 @@ YY_DECL
 		yy_bp = yy_cp;
 
 		yy_current_state = (yy_start);
-		yy_current_state += YY_AT_BOL();
-
-		(yy_state_ptr) = (yy_state_buf);
-		*(yy_state_ptr)++ = yy_current_state;
 
 yy_match:
 		do
 			{
 			YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)] ;
+			if ( yy_accept[yy_current_state] )
+				{
+				(yy_last_accepting_state) = yy_current_state;
+				(yy_last_accepting_cpos) = yy_cp;
+				}
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 167 )
+				if ( yy_current_state >= 126 )
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-			*(yy_state_ptr)++ = yy_current_state;
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 263 );
+		while ( yy_base[yy_current_state] != 332 );
 
 yy_find_action:
-		yy_current_state = *--(yy_state_ptr);
-		(yy_lp) = yy_accept[yy_current_state];
-
-find_rule: /* we branch to this label when backing up */
-
-		for ( ; ; ) /* until we find what rule we matched */
-			{
-			if ( (yy_lp) && (yy_lp) < yy_accept[yy_current_state + 1] )
-				{
-				yy_act = yy_acclist[(yy_lp)];
-					{
-					(yy_full_match) = yy_cp;
-					break;
-					}
-				}
-			--yy_cp;
-			yy_current_state = *--(yy_state_ptr);
-			(yy_lp) = yy_accept[yy_current_state];
+		yy_act = yy_accept[yy_current_state];
+		if ( yy_act == 0 )
+			{ /* have to back up */
+			yy_cp = (yy_last_accepting_cpos);
+			yy_current_state = (yy_last_accepting_state);
+			yy_act = yy_accept[yy_current_state];
 			}
 
 		YY_DO_BEFORE_ACTION;
@@ -897,152 +860,178 @@ do_action:	/* This label is used only to access EOF actions. */
 
 		switch ( yy_act )
 	{ /* beginning of action switch */
+			case 0: /* must back up */
+			/* undo the effects of YY_DO_BEFORE_ACTION */
+			*yy_cp = (yy_hold_char);
+			yy_cp = (yy_last_accepting_cpos);
+			yy_current_state = (yy_last_accepting_state);
+			goto yy_find_action;
+
 case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
-#line 25 "./little_lexer.l"
+#line 39 "./little_lexer.l"
 {
     nRow++;
     count++;
     }
 	YY_BREAK
 case 2:
-YY_RULE_SETUP
-#line 30 "./little_lexer.l"
-{
-    //防止匹配到的内容放在首部，前面无空格，出现单词数目不增加的情况
-    nWord++;
-    REJECT;
-}
-	YY_BREAK
-case 3:
 *yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
 (yy_c_buf_p) = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
-#line 36 "./little_lexer.l"
+#line 44 "./little_lexer.l"
 {
     //处理掉句末和#前的空格
-    
+
     nRow++;
     count=count+yyleng;
     }
 	YY_BREAK
-case 4:
+case 3:
 YY_RULE_SETUP
-#line 43 "./little_lexer.l"
+#line 51 "./little_lexer.l"
 {
      //出现空格，而且后面有内容，则字数加1
     count=count+yyleng;
        nWord++;
 }
 	YY_BREAK
-case 5:
+case 4:
 YY_RULE_SETUP
-#line 50 "./little_lexer.l"
+#line 58 "./little_lexer.l"
 {
     //，和“直接忽略，啥都不做
+    if(line_start)
+        nWord++;
     count=yyleng+count;
 }
 	YY_BREAK
-case 6:
+case 5:
 YY_RULE_SETUP
-#line 55 "./little_lexer.l"
+#line 65 "./little_lexer.l"
 {
+    if(line_start)
+        nWord++;
     printf("\n#%d TYPEID %s",nRow,yytext);
     count=yyleng+count;
 }
 	YY_BREAK
-case 7:
+case 6:
 YY_RULE_SETUP
-#line 60 "./little_lexer.l"
+#line 72 "./little_lexer.l"
 {
+    if(line_start)
+        nWord++;
     printf("\n#%d KEYWORD %s",nRow,yytext);
     count=yyleng+count;
 }
 	YY_BREAK
-case 8:
+case 7:
 YY_RULE_SETUP
-#line 65 "./little_lexer.l"
+#line 79 "./little_lexer.l"
 {
-    if((yytext!="stdeer")&&(yytext!="stdout"))
-        printf("\n#%d OBJECTED %s",nRow,yytext);
+    if(line_start)
+        nWord++;
+    printf("\n#%d OBJECTED %s",nRow,yytext);
     count=yyleng+count;
 }
 	YY_BREAK
-case 9:
+case 8:
 YY_RULE_SETUP
-#line 71 "./little_lexer.l"
+#line 86 "./little_lexer.l"
 {
-    if(yytext!=",")
-        printf("\n#%d %s",nRow,yytext);
+    if(line_start)
+        nWord++;
+    printf("\n#%d %s",nRow,yytext);
     count=yyleng+count;
 }
 	YY_BREAK
-case 10:
+case 9:
 YY_RULE_SETUP
-#line 77 "./little_lexer.l"
+#line 93 "./little_lexer.l"
 {
     printf("\n#%d %s",nRow,yytext);
        nWord++;
     count=yyleng+count;
 }
 	YY_BREAK
-case 11:
+case 10:
 YY_RULE_SETUP
-#line 84 "./little_lexer.l"
+#line 100 "./little_lexer.l"
 {
+    if(line_start)
+        nWord++;
     printf("\n#%d Const %s",nRow,yytext);
     count=yyleng+count;
 }
 	YY_BREAK
-case 12:
+case 11:
 YY_RULE_SETUP
-#line 90 "./little_lexer.l"
+#line 108 "./little_lexer.l"
 {
     //处理注释情况，默认第一行注释则认为是标题进行显示，其他注释直接不显示
     //注释中的字符数和单词数同样统计
-    
-    char c;
+    if(line_start)
+        nWord++;
     count++;
     if(nRow==0)
         printf("#name");
-        
-    c=input();
-    while(c!='\n'){
-        if(nRow==0)
-            putchar(c);
-        if(c==' ')
-        {
-            while((c=input())==' ')
-            {
-                if(nRow==0)
-                    putchar(c);
-                count++;
-            }
-            if(c!='\n')
-            {
-                   nWord++;
-                count++;
-            }
-        }
-        else
-        {
-            count++;
-            c=input();
-        }
-    }
+    BEGIN(COMMENT);
+}
+	YY_BREAK
+case 12:
+YY_RULE_SETUP
+#line 119 "./little_lexer.l"
+{
+    if(nRow==0)
+        fwrite(yytext,1,yyleng,stdout);
+    count=count+yyleng;
+}
+	YY_BREAK
+case 13:
+*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+(yy_c_buf_p) = yy_cp -= 1;
+YY_DO_BEFORE_ACTION; /* set up yytext again */
+YY_RULE_SETUP
+#line 125 "./little_lexer.l"
+{
+    //行尾的空格中第一个不计数
+    if(nRow==0)
+        fwrite(yytext,1,yyleng,stdout);
+    count=count+yyleng-1;
+}
+	YY_BREAK
+case 14:
+YY_RULE_SETUP
+#line 132 "./little_lexer.l"
+{
+    //空格后面还有内容，则字数加1
+    if(nRow==0)
+        fwrite(yytext,1,yyleng,stdout);
+    count=count+yyleng;
+    nWord++;
+}
+	YY_BREAK
+case 15:
+/* rule 15 can match eol */
+YY_RULE_SETUP
+#line 140 "./little_lexer.l"
+{
     nRow++;
     count++;
+    BEGIN(INITIAL);
 }
 	YY_BREAK
-case 13:
+case 16:
 YY_RULE_SETUP
-#line 129 "./little_lexer.l"
+#line 148 "./little_lexer.l"
 ECHO;
 	YY_BREAK
-#line 1045 "lex.yy.c"
+#line 1033 "lex.yy.c"
 			case YY_STATE_EOF(INITIAL):
+			case YY_STATE_EOF(COMMENT):
 				yyterminate();
 
 	case YY_END_OF_BUFFER:
@@ -1234,8 +1223,39 @@ static int yy_get_next_buffer (void)
 		while ( num_to_read <= 0 )
 			{ /* Not enough room in the buffer - grow it. */
 
-			YY_FATAL_ERROR(
-"input buffer overflow, can't enlarge buffer because scanner uses REJECT" );
+			/* just a shorter name for the current buffer */
+			YY_BUFFER_STATE b = YY_CURRENT_BUFFER_LVALUE;
+
+			int yy_c_buf_p_offset =
+				(int) ((yy_c_buf_p) - b->yy_ch_buf);
+
+			if ( b->yy_is_our_buffer )
+				{
+				int new_size = b->yy_buf_size * 2;
+
+				if ( new_size <= 0 )
+					b->yy_buf_size += b->yy_buf_size / 8;
+				else
+					b->yy_buf_size *= 2;
+
+				b->yy_ch_buf = (char *)
+					/* Include room in for 2 EOB chars. */
+					yyrealloc( (void *) b->yy_ch_buf,
+							 (yy_size_t) (b->yy_buf_size + 2)  );
+				}
+			else
+				/* Can't grow it, we don't own it. */
+				b->yy_ch_buf = NULL;
+
+			if ( ! b->yy_ch_buf )
+				YY_FATAL_ERROR(
+				"fatal error - scanner input buffer overflow" );
+
+			(yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];
+
+			num_to_read = YY_CURRENT_BUFFER_LVALUE->yy_buf_size -
+						number_to_move - 1;
+
 
 			}
 
@@ -1296,22 +1316,22 @@ static int yy_get_next_buffer (void)
 	char *yy_cp;
     
 	yy_current_state = (yy_start);
-	yy_current_state += YY_AT_BOL();
-
-	(yy_state_ptr) = (yy_state_buf);
-	*(yy_state_ptr)++ = yy_current_state;
 
 	for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
 		{
 		YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
+		if ( yy_accept[yy_current_state] )
+			{
+			(yy_last_accepting_state) = yy_current_state;
+			(yy_last_accepting_cpos) = yy_cp;
+			}
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 167 )
+			if ( yy_current_state >= 126 )
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-		*(yy_state_ptr)++ = yy_current_state;
 		}
 
 	return yy_current_state;
@@ -1325,18 +1345,22 @@ static int yy_get_next_buffer (void)
     static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
 {
 	int yy_is_jam;
-    
+    	char *yy_cp = (yy_c_buf_p);
+
 	YY_CHAR yy_c = 1;
+	if ( yy_accept[yy_current_state] )
+		{
+		(yy_last_accepting_state) = yy_current_state;
+		(yy_last_accepting_cpos) = yy_cp;
+		}
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 167 )
+		if ( yy_current_state >= 126 )
 			yy_c = yy_meta[yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-	yy_is_jam = (yy_current_state == 166);
-	if ( ! yy_is_jam )
-		*(yy_state_ptr)++ = yy_current_state;
+	yy_is_jam = (yy_current_state == 125);
 
 		return yy_is_jam ? 0 : yy_current_state;
 }
@@ -1452,8 +1476,6 @@ static int yy_get_next_buffer (void)
 	*(yy_c_buf_p) = '\0';	/* preserve yytext */
 	(yy_hold_char) = *++(yy_c_buf_p);
 
-	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = (c == '\n');
-
 	return c;
 }
 #endif	/* ifndef YY_NO_INPUT */
@@ -1927,11 +1949,6 @@ static int yy_init_globals (void)
     (yy_init) = 0;
     (yy_start) = 0;
 
-    (yy_state_buf) = 0;
-    (yy_state_ptr) = 0;
-    (yy_full_match) = 0;
-    (yy_lp) = 0;
-
 /* Defined in main.c */
 #ifdef YY_STDINIT
     yyin = stdin;
@@ -1962,9 +1979,6 @@ int yylex_destroy  (void)
 	yyfree((yy_buffer_stack) );
 	(yy_buffer_stack) = NULL;
 
-    yyfree ( (yy_state_buf) );
-    (yy_state_buf)  = NULL;
-
     /* Reset the globals. This is important in a non-reentrant scanner so the next time
      * yylex() is called, initialization will occur. */
     yy_init_globals( );
@@ -2022,8 +2036,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 129 "./little_lexer.l"
-
+#line 148 "./little_lexer.l"
 
 /*处理函数（User subroutines）*/
 int main()
@@ -0,0 +1,530 @@
+#!/usr/bin/env python3
+"""没有flex时由little_lexer.l重新生成lex.yy.c。
+
+用法: python3 mklexer.py [骨架 [little_lexer.l [输出]]]，默认都是本目录的
+lex.yy.c与little_lexer.l，即在原文件上更新。
+
+读入.l的定义与规则，构造DFA（最长匹配，同长时取靠前的规则，`r$`按定长
+尾随上下文处理），按flex的格式写出压缩的yy_accept/yy_ec/yy_base/yy_def/
+yy_nxt/yy_chk表，连同各规则的动作、第一节与第三节的代码，替换进flex 2.6.4
+生成的扫描器骨架。骨架可以是上次生成的lex.yy.c，也可以是flex为使用REJECT
+的旧规则生成的文件，后者会先改成不带REJECT的形式。装有flex时
+`flex little_lexer.l`得到的扫描器与此等价。
+"""
+import re, sys
+
+LPATH = './little_lexer.l'
+BANNER = ('/* A lexical scanner in the form flex 2.6.4 generates: mklexer.py wrote\n'
+          '   the tables and actions for little_lexer.l into this skeleton.  With\n'
+          '   flex installed, flex little_lexer.l gives an equivalent scanner. */\n')
+
+def read_l(path):
+    lines = open(path, encoding='utf-8').read().split('\n')
+    return lines
+
+# ---------------------------------------------------------------- regex
+class P:
+    def __init__(s, text, defs):
+        s.t, s.i, s.defs = text, 0, defs
+    def peek(s):
+        return s.t[s.i] if s.i < len(s.t) else None
+    def take(s):
+        c = s.t[s.i]; s.i += 1; return c
+    def alt(s):
+        a = s.cat()
+        while s.peek() == '|':
+            s.take(); a = ('alt', a, s.cat())
+        return a
+    def cat(s):
+        a = None
+        while s.peek() is not None and s.peek() not in '|)':
+            if s.peek() == '$' and s.i == len(s.t) - 1:
+                break
+            b = s.rep()
+            a = b if a is None else ('cat', a, b)
+        return a if a is not None else ('eps',)
+    def rep(s):
+        a = s.atom()
+        while s.peek() in ('*', '+', '?'):
+            a = ({'*': 'star', '+': 'plus', '?': 'opt'}[s.take()], a)
+        return a
+    def esc(s):
+        c = s.take()
+        return {'n': 10, 't': 9}.get(c, ord(c))
+    def atom(s):
+        c = s.take()
+        if c == '(':
+            a = s.alt(); assert s.take() == ')'; return a
+        if c == '[':
+            neg = False
+            if s.peek() == '^':
+                s.take(); neg = True
+            chars = set()
+            while s.peek() != ']':
+                lo = s.esc() if s.peek() == '\\' and s.take() else ord(s.take())
+                if s.peek() == '-' and s.t[s.i + 1] != ']':
+                    s.take()
+                    hi = s.esc() if s.peek() == '\\' and s.take() else ord(s.take())
+                    chars |= set(range(lo, hi + 1))
+                else:
+                    chars.add(lo)
+            s.take()
+            if neg:
+                chars = set(range(256)) - chars
+            return ('set', frozenset(chars))
+        if c == '"':
+            a = None
+            while s.peek() != '"':
+                ch = s.esc() if s.peek() == '\\' and s.take() else ord(s.take())
+                b = ('set', frozenset([ch]))
+                a = b if a is None else ('cat', a, b)
+            s.take()
+            return a
+        if c == '{':
+            j = s.t.index('}', s.i)
+            name = s.t[s.i:j]; s.i = j + 1
+            return P(s.defs[name], s.defs).alt()
+        if c == '.':
+            return ('set', frozenset(set(range(256)) - {10}))
+        if c == '\\':
+            return ('set', frozenset([s.esc()]))
+        return ('set', frozenset([ord(c)]))
+
+# ---------------------------------------------------------------- NFA
+class NFA:
+    def __init__(s):
+        s.eps, s.edges, s.acc = [], [], {}
+    def new(s):
+        s.eps.append([]); s.edges.append([]); return len(s.eps) - 1
+    def build(s, a):
+        k = a[0]
+        if k == 'set':
+            x, y = s.new(), s.new(); s.edges[x].append((a[1], y)); return x, y
+        if k == 'eps':
+            x = s.new(); return x, x
+        if k == 'cat':
+            x1, y1 = s.build(a[1]); x2, y2 = s.build(a[2]); s.eps[y1].append(x2); return x1, y2
+        if k == 'alt':
+            x, y = s.new(), s.new()
+            for b in a[1:]:
+                bx, by = s.build(b); s.eps[x].append(bx); s.eps[by].append(y)
+            return x, y
+        x, y = s.new(), s.new()
+        bx, by = s.build(a[1])
+        s.eps[x].append(bx); s.eps[by].append(y)
+        if k in ('star', 'opt'):
+            s.eps[x].append(y)
+        if k in ('star', 'plus'):
+            s.eps[by].append(bx)
+        return x, y
+    def closure(s, states):
+        st, seen = list(states), set(states)
+        while st:
+            for t in s.eps[st.pop()]:
+                if t not in seen:
+                    seen.add(t); st.append(t)
+        return frozenset(seen)
+
+# ---------------------------------------------------------------- parse .l
+def parse(lines):
+    sect = [i for i, l in enumerate(lines) if l == '%%']
+    s1, s2 = sect[0], sect[1]
+    defs, scs, defcomments = {}, ['INITIAL'], []
+    code_start = code_end = None
+    i = 0
+    while i < s1:
+        l = lines[i]
+        if l == '%{':
+            code_start = i + 1
+            while lines[i] != '%}':
+                i += 1
+            code_end = i
+        elif l.startswith('/*'):
+            defcomments.append(l)
+        elif l.startswith('%x'):
+            scs += l.split()[1:]
+        elif l and not l[0].isspace():
+            name, val = l.split(None, 1)
+            defs[name] = val.strip()
+        i += 1
+    rules = []
+    i = s1 + 1
+    while i < s2:
+        l = lines[i]
+        if l.strip() == '':
+            i += 1; continue
+        m = re.match(r'\s*(?:<(\w+)>)?', l)
+        k, br, q = m.end(), False, False
+        while br or q or not l[k].isspace():
+            if l[k] == '\\':
+                k += 1
+            elif q:
+                q = l[k] != '"'
+            elif l[k] == '"':
+                q = True
+            elif l[k] == '[':
+                br = True
+            elif l[k] == ']':
+                br = False
+            k += 1
+        sc, pat = m.group(1) or 'INITIAL', l[m.end():k]
+        assert l[k:].strip() == '{', l
+        j, depth, body = i, 0, []
+        while True:
+            body.append(lines[j])
+            depth += lines[j].count('{') - lines[j].count('}')
+            if depth == 0 and j > i or (j == i and depth == 0):
+                break
+            j += 1
+        body[0] = body[0][body[0].index('{', k):]
+        rules.append(dict(line=i + 1, sc=sc, pat=pat, action='\n'.join(body)))
+        i = j + 1
+    return dict(defs=defs, scs=scs, code=(code_start, code_end), defcomments=defcomments,
+                rules=rules, s1=s1, s2=s2)
+
+# ---------------------------------------------------------------- DFA
+def build(spec):
+    nfa = NFA()
+    rules = spec['rules']
+    starts = {sc: nfa.new() for sc in spec['scs']}
+    trail = {}
+    for n, r in enumerate(rules, 1):
+        pat = r['pat']
+        tc = pat.endswith('$') and not pat.endswith('\\$')
+        ast = P(pat[:-1] if tc else pat, spec['defs']).alt()
+        if tc:
+            ast = ('cat', ast, ('set', frozenset([10])))
+            trail[n] = 1
+        r['can_eol'] = not tc and 10 in chars_of(ast)
+        x, y = nfa.build(ast)
+        nfa.acc[y] = n
+        nfa.eps[starts[r['sc']]].append(x)
+    default = len(rules) + 1
+    x, y = nfa.build(('set', frozenset(range(256))))
+    nfa.acc[y] = default
+    for sc in spec['scs']:
+        nfa.eps[starts[sc]].append(x)
+
+    # equivalence classes, numbered by first character so NUL's class is 1
+    sets = set()
+    for e in nfa.edges:
+        for cs, _ in e:
+            sets.add(cs)
+    sig = {}
+    ec = [0] * 256
+    for c in range(256):
+        key = tuple(c in cs for cs in sorted(sets, key=sorted))
+        if key not in sig:
+            sig[key] = len(sig) + 1
+        ec[c] = sig[key]
+    numecs = len(sig)
+    rep = {}
+    for c in range(256):
+        rep.setdefault(ec[c], c)
+
+    def move(S, c):
+        out = set()
+        for s in S:
+            for cs, t in nfa.edges[s]:
+                if c in cs:
+                    out.add(t)
+        return nfa.closure(out)
+
+    def accept(S):
+        a = [nfa.acc[s] for s in S if s in nfa.acc]
+        return min(a) if a else 0
+
+    # states: 1..2*nsc start states, then end-of-buffer, then the rest
+    order, index = [], {}
+    startsets = []
+    for sc in spec['scs']:
+        S = nfa.closure([starts[sc]])
+        startsets += [S, S]
+    for S in startsets:
+        order.append(S)
+    index.update({S: i + 1 for i, S in enumerate(order) if S not in index})
+    eob = len(order) + 1
+    order.append('EOB')
+    trans = {}
+    queue = list(range(1, len(order) + 1))
+    qi = 0
+    while qi < len(queue):
+        n = queue[qi]; qi += 1
+        S = order[n - 1]
+        if S == 'EOB':
+            trans[n] = {}; continue
+        row = {}
+        for c in range(1, numecs + 1):
+            T = move(S, rep[c])
+            if not T:
+                continue
+            if T not in index:
+                order.append(T); index[T] = len(order); queue.append(len(order))
+            row[c] = index[T]
+        trans[n] = row
+    lastdfa = len(order)
+    acc = [0] * (lastdfa + 2)
+    for n in range(1, lastdfa + 1):
+        acc[n] = default + 1 if order[n - 1] == 'EOB' else accept(order[n - 1])
+    jam = lastdfa + 1
+
+    # pack rows first-fit; states without transitions share the jam base
+    used = {}
+    base = [0] * (jam + 1)
+    dflt = [jam] * (jam + 1)
+    dflt[0] = 0
+    dflt[jam] = 0
+    nxt, chk = {}, {}
+    full = lambda n: [trans[n].get(c, jam) for c in range(1, numecs + 1)]
+    done = []
+    for n in range(1, lastdfa + 1):
+        row = trans[n]
+        if not row:
+            base[n] = None; continue
+        fn = full(n)
+        best = None
+        for p in done:
+            fp = full(p)
+            diff = {c: fn[c - 1] for c in range(1, numecs + 1) if fn[c - 1] != fp[c - 1]}
+            if best is None or len(diff) < len(best[1]):
+                best = (p, diff)
+        if best is not None and len(best[1]) < len(row):
+            dflt[n], row = best[0], best[1]
+        done.append(n)
+        b = 0
+        while any((b + c) in chk for c in row):
+            b += 1
+        base[n] = b
+        for c, t in row.items():
+            nxt[b + c] = t; chk[b + c] = n
+    jambase = (max(chk) + 1) if chk else 0
+    for c in range(0, numecs + 1):
+        nxt[jambase + c] = eob if c == 0 else jam
+        chk[jambase + c] = jam
+    base[jam] = jambase
+    for n in range(1, lastdfa + 1):
+        if base[n] is None:
+            base[n] = jambase
+    size = jambase + numecs + 1
+    return dict(ec=ec, numecs=numecs, acc=acc, base=base, dflt=dflt,
+                nxt=[nxt.get(i, 0) for i in range(size)],
+                chk=[chk.get(i, 0) for i in range(size)],
+                lastdfa=lastdfa, jam=jam, jambase=jambase, trail=trail,
+                default=default, nul_ec=ec[0], trans=trans)
+
+def chars_of(a):
+    if a[0] == 'set':
+        return set(a[1])
+    if a[0] == 'eps':
+        return set()
+    out = set()
+    for b in a[1:]:
+        out |= chars_of(b)
+    return out
+
+# ---------------------------------------------------------------- output
+def table(decl, name, vals):
+    out = ['static const %s %s[%d] =\n    {   %d,\n' % (decl, name, len(vals), vals[0])]
+    line, pos, dataline = '', 0, 0
+    for v in vals[1:]:
+        if pos >= 10:
+            out.append(line + ',\n')
+            dataline += 1
+            if dataline >= 10:
+                out.append('\n'); dataline = 0
+            line, pos = '', 0
+        line += ('    ' if pos == 0 else ',') + '%5d' % v
+        pos += 1
+    if pos:
+        out.append(line + '\n')
+    out.append('    } ;\n\n')
+    return ''.join(out)
+
+def int_decl(vals):
+    return 'flex_int16_t' if max(vals) < 32767 else 'flex_int32_t'
+
+def one(src, old, new):
+    assert src.count(old) == 1, old[:80]
+    return src.replace(old, new)
+
+# 只在REJECT骨架中出现的部分
+def strip(src, old, new):
+    return one(src, old, new) if old in src else src
+
+def main(skel_path, lpath, out_path):
+    lines = read_l(lpath)
+    spec = parse(lines)
+    d = build(spec)
+    src = open(skel_path, encoding='utf-8').read()
+    nrules = len(spec['rules']) + 1
+    J, X = d['jam'], d['lastdfa'] + 2
+
+    tabs = ('#define YY_NUM_RULES %d\n#define YY_END_OF_BUFFER %d\n' % (nrules, nrules + 1)
+            + '/* This struct is not used in this scanner,\n   but its presence is necessary. */\n'
+            + 'struct yy_trans_info\n\t{\n\tflex_int32_t yy_verify;\n\tflex_int32_t yy_nxt;\n\t};\n'
+            + table(int_decl(d['acc']), 'yy_accept', d['acc'])
+            + table('YY_CHAR', 'yy_ec', [0] + d['ec'][1:])
+            + table('YY_CHAR', 'yy_meta', [0] + [1] * d['numecs'])
+            + table(int_decl(d['base']), 'yy_base', d['base'])
+            + table(int_decl(d['dflt']), 'yy_def', d['dflt'])
+            + table(int_decl(d['nxt']), 'yy_nxt', d['nxt'])
+            + table(int_decl(d['chk']), 'yy_chk', d['chk'])
+            + 'static yy_state_type yy_last_accepting_state;\n'
+            + 'static char *yy_last_accepting_cpos;\n\n'
+            + 'extern int yy_flex_debug;\nint yy_flex_debug = 0;\n\n'
+            + '/* The intent behind this definition is that it\'ll catch\n'
+            + ' * any uses of REJECT which flex missed.\n */\n'
+            + '#define REJECT reject_used_but_not_detected\n')
+    a = src.index('#define YY_NUM_RULES')
+    b = src.index('#define yymore()')
+    src = src[:a] + tabs + src[b:]
+
+    # section 1
+    cs, ce = spec['code']
+    sec1 = '#line 1 "%s"\n#line %d "%s"\n' % (LPATH, cs + 1, LPATH)
+    sec1 += ''.join(l + '\n' for l in lines[cs:ce])
+    sec1 += '#line @ "lex.yy.c"\n'
+    sec1 += ''.join(l + '\n' for l in spec['defcomments'])
+    sec1 += '#line @ "lex.yy.c"\n\n'
+    sec1 += ''.join('#define %s %d\n' % (sc, i) for i, sc in enumerate(spec['scs'])) + '\n'
+    a = src.index('#line 1 "./little_lexer.l"')
+    b = src.index('#ifndef YY_NO_UNISTD_H')
+    src = src[:a] + sec1 + src[b:]
+
+    if '/* A lexical scanner generated by flex */\n' in src:
+        src = one(src, '/* A lexical scanner generated by flex */\n', BANNER)
+    src = strip(src, '#define YY_RULE_SETUP \\\n\tif ( yyleng > 0 ) \\\n'
+              '\t\tYY_CURRENT_BUFFER_LVALUE->yy_at_bol = \\\n'
+              '\t\t\t\t(yytext[yyleng - 1] == \'\\n\'); \\\n\tYY_USER_ACTION\n',
+              '#define YY_RULE_SETUP \\\n\tYY_USER_ACTION\n')
+    src = strip(src, '        /* Create the reject buffer large enough to save one state per allowed character. */\n'
+              '        if ( ! (yy_state_buf) )\n'
+              '            (yy_state_buf) = (yy_state_type *)yyalloc(YY_STATE_BUF_SIZE  );\n'
+              '            if ( ! (yy_state_buf) )\n'
+              '                YY_FATAL_ERROR( "out of dynamic memory in yylex()" );\n\n', '')
+    src = re.sub(r'\n\t\{\n#line \d+ "\./little_lexer\.l"\n',
+                 '\n\t{\n#line %d "%s"\n' % (spec['s1'] + 2, LPATH), src, count=1)
+    src = strip(src, '\t\tyy_current_state = (yy_start);\n\t\tyy_current_state += YY_AT_BOL();\n\n'
+              '\t\t(yy_state_ptr) = (yy_state_buf);\n\t\t*(yy_state_ptr)++ = yy_current_state;\n',
+              '\t\tyy_current_state = (yy_start);\n')
+
+    def step(ind, cls):
+        return (ind + 'YY_CHAR yy_c = %s;\n' % cls
+                + ind + 'if ( yy_accept[yy_current_state] )\n'
+                + ind + '\t{\n'
+                + ind + '\t(yy_last_accepting_state) = yy_current_state;\n'
+                + ind + '\t(yy_last_accepting_cpos) = yy_cp;\n'
+                + ind + '\t}\n'
+                + ind + 'while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )\n'
+                + ind + '\t{\n'
+                + ind + '\tyy_current_state = (int) yy_def[yy_current_state];\n'
+                + ind + '\tif ( yy_current_state >= %d )\n' % X
+                + ind + '\t\tyy_c = yy_meta[yy_c];\n'
+                + ind + '\t}\n'
+                + ind + 'yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];\n')
+
+    a = src.index('yy_match:\n')
+    b = src.index('do_action:')
+    src = (src[:a] + 'yy_match:\n\t\tdo\n\t\t\t{\n'
+           + step('\t\t\t', 'yy_ec[YY_SC_TO_UI(*yy_cp)] ')
+           + '\t\t\t++yy_cp;\n\t\t\t}\n'
+           + '\t\twhile ( yy_base[yy_current_state] != %d );\n\n' % d['jambase']
+           + 'yy_find_action:\n\t\tyy_act = yy_accept[yy_current_state];\n'
+           + '\t\tif ( yy_act == 0 )\n\t\t\t{ /* have to back up */\n'
+           + '\t\t\tyy_cp = (yy_last_accepting_cpos);\n'
+           + '\t\t\tyy_current_state = (yy_last_accepting_state);\n'
+           + '\t\t\tyy_act = yy_accept[yy_current_state];\n\t\t\t}\n\n'
+           + '\t\tYY_DO_BEFORE_ACTION;\n\n' + src[b:])
+
+    # actions
+    acts = ['\t{ /* beginning of action switch */\n'
+            '\t\t\tcase 0: /* must back up */\n'
+            '\t\t\t/* undo the effects of YY_DO_BEFORE_ACTION */\n'
+            '\t\t\t*yy_cp = (yy_hold_char);\n'
+            '\t\t\tyy_cp = (yy_last_accepting_cpos);\n'
+            '\t\t\tyy_current_state = (yy_last_accepting_state);\n'
+            '\t\t\tgoto yy_find_action;\n\n']
+    for n, r in enumerate(spec['rules'], 1):
+        acts.append('case %d:\n' % n)
+        if r['can_eol']:
+            acts.append('/* rule %d can match eol */\n' % n)
+        if n in d['trail']:
+            acts.append('*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */\n'
+                        '(yy_c_buf_p) = yy_cp -= %d;\n'
+                        'YY_DO_BEFORE_ACTION; /* set up yytext again */\n' % d['trail'][n])
+        acts.append('YY_RULE_SETUP\n#line %d "%s"\n%s\n\tYY_BREAK\n' % (r['line'], LPATH, r['action']))
+    acts.append('case %d:\nYY_RULE_SETUP\n#line %d "%s"\nECHO;\n\tYY_BREAK\n'
+                % (nrules, spec['s2'] + 1, LPATH))
+    acts.append('#line @ "lex.yy.c"\n')
+    acts.append(''.join('\t\t\tcase YY_STATE_EOF(%s):\n' % sc for sc in spec['scs']))
+    acts.append('\t\t\t\tyyterminate();\n')
+    a = src.index('\t{ /* beginning of action switch */\n')
+    b = src.index('\tcase YY_END_OF_BUFFER:')
+    src = src[:a] + ''.join(acts) + '\n' + src[b:]
+
+    # yy_get_next_buffer can grow the buffer without REJECT
+    src = strip(src, '\t\t\tYY_FATAL_ERROR(\n'
+              '"input buffer overflow, can\'t enlarge buffer because scanner uses REJECT" );\n',
+              '\t\t\t/* just a shorter name for the current buffer */\n'
+              '\t\t\tYY_BUFFER_STATE b = YY_CURRENT_BUFFER_LVALUE;\n\n'
+              '\t\t\tint yy_c_buf_p_offset =\n'
+              '\t\t\t\t(int) ((yy_c_buf_p) - b->yy_ch_buf);\n\n'
+              '\t\t\tif ( b->yy_is_our_buffer )\n'
+              '\t\t\t\t{\n'
+              '\t\t\t\tint new_size = b->yy_buf_size * 2;\n\n'
+              '\t\t\t\tif ( new_size <= 0 )\n'
+              '\t\t\t\t\tb->yy_buf_size += b->yy_buf_size / 8;\n'
+              '\t\t\t\telse\n'
+              '\t\t\t\t\tb->yy_buf_size *= 2;\n\n'
+              '\t\t\t\tb->yy_ch_buf = (char *)\n'
+              '\t\t\t\t\t/* Include room in for 2 EOB chars. */\n'
+              '\t\t\t\t\tyyrealloc( (void *) b->yy_ch_buf,\n'
+              '\t\t\t\t\t\t\t (yy_size_t) (b->yy_buf_size + 2)  );\n'
+              '\t\t\t\t}\n'
+              '\t\t\telse\n'
+              '\t\t\t\t/* Can\'t grow it, we don\'t own it. */\n'
+              '\t\t\t\tb->yy_ch_buf = NULL;\n\n'
+              '\t\t\tif ( ! b->yy_ch_buf )\n'
+              '\t\t\t\tYY_FATAL_ERROR(\n'
+              '\t\t\t\t"fatal error - scanner input buffer overflow" );\n\n'
+              '\t\t\t(yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];\n\n'
+              '\t\t\tnum_to_read = YY_CURRENT_BUFFER_LVALUE->yy_buf_size -\n'
+              '\t\t\t\t\t\tnumber_to_move - 1;\n\n')
+
+    # yy_get_previous_state / yy_try_NUL_trans
+    a = src.index('\tyy_current_state = (yy_start);\n',
+                  src.index('yy_get_previous_state (void)\n{'))
+    b = src.index('\treturn yy_current_state;\n}')
+    src = (src[:a] + '\tyy_current_state = (yy_start);\n\n'
+           '\tfor ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )\n\t\t{\n'
+           + step('\t\t', '(*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : %d)' % d['nul_ec'])
+           + '\t\t}\n\n' + src[b:])
+    a = src.index('\tint yy_is_jam;\n')
+    b = src.index('\t\treturn yy_is_jam ? 0 : yy_current_state;')
+    src = (src[:a] + '\tint yy_is_jam;\n    \tchar *yy_cp = (yy_c_buf_p);\n\n'
+           + step('\t', '%d' % d['nul_ec'])
+           + '\tyy_is_jam = (yy_current_state == %d);\n\n' % J + src[b:])
+
+    src = strip(src, '\t(yy_hold_char) = *++(yy_c_buf_p);\n\n'
+              '\tYY_CURRENT_BUFFER_LVALUE->yy_at_bol = (c == \'\\n\');\n\n',
+              '\t(yy_hold_char) = *++(yy_c_buf_p);\n\n')
+    src = strip(src, '    (yy_state_buf) = 0;\n    (yy_state_ptr) = 0;\n'
+              '    (yy_full_match) = 0;\n    (yy_lp) = 0;\n\n', '')
+    src = strip(src, '    yyfree ( (yy_state_buf) );\n    (yy_state_buf)  = NULL;\n\n', '')
+
+    # section 3
+    a = src.rindex('#line ', 0, src.rindex('"%s"' % LPATH))
+    src = src[:a] + '#line %d "%s"\n' % (spec['s2'] + 1, LPATH) + '\n'.join(lines[spec['s2'] + 1:])
+
+    # renumber the "lex.yy.c" line directives
+    out = src.split('\n')
+    for i, l in enumerate(out):
+        if i and l.endswith(' "lex.yy.c"') and l.startswith('#line'):
+            out[i] = '#line %d "lex.yy.c"' % (i + 2)
+    open(out_path, 'w', encoding='utf-8').write('\n'.join(out))
+    return d
+
+if __name__ == '__main__':
+    args = sys.argv[1:] + ['lex.yy.c', LPATH, 'lex.yy.c'][len(sys.argv) - 1:]
+    d = main(*args)
+    print('states', d['lastdfa'], 'ecs', d['numecs'], 'jambase', d['jambase'], 'nul_ec', d['nul_ec'])
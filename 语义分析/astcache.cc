@@ -0,0 +1,727 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: astcache.cc
+//
+// Writes and reads binary typed ASTs, and the save() method of each node
+// class.  See astcache.h for the format.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include "astcache.h"
+#include "symmap.h"
+
+enum { ID_TABLE, INT_TABLE, FLOAT_TABLE, STRING_TABLE };
+
+extern thread_local int node_lineno;
+
+#define FNV_OFFSET_BASIS 14695981039346656037ull
+
+// 64-bit FNV-1a, going on from h over n bytes
+static unsigned long long fnv1a(unsigned long long h, const char *data, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char) data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+unsigned long long ast_cache_key(FILE *in)
+{
+    unsigned long long h = FNV_OFFSET_BASIS;
+    char buf[65536];
+    size_t n;
+    long start = ftell(in);
+
+    if (start < 0 || fseek(in, start, SEEK_SET) != 0)
+        return 0;               // a pipe: what is read is gone
+    while ((n = fread(buf, 1, sizeof buf, in)) > 0)
+        h = fnv1a(h, buf, n);
+    bool failed = ferror(in) != 0;
+    clearerr(in);
+    if (fseek(in, start, SEEK_SET) != 0) {
+        perror("ast_cache_key");
+        exit(1);
+    }
+    if (failed)
+        return 0;
+    return h != 0 ? h : 1;      // 0 is no key
+}
+
+static void put_key(std::string &out, unsigned long long key)
+{
+    for (int i = 0; i < 8; i++)
+        out += (char) ((key >> (8 * i)) & 0xff);
+}
+
+static unsigned long long get_key(const char *in)
+{
+    unsigned long long key = 0;
+    for (int i = 0; i < 8; i++)
+        key |= (unsigned long long) (unsigned char) in[i] << (8 * i);
+    return key;
+}
+
+// the hash of what follows the header
+static unsigned long long payload_hash(const char *data, size_t n)
+{
+    return fnv1a(FNV_OFFSET_BASIS, data + AST_CACHE_HEADER, n - AST_CACHE_HEADER);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AstWriter
+//
+///////////////////////////////////////////////////////////////////////////
+
+AstWriter::AstWriter(FILE *out_, unsigned long long key)
+    : out(out_), lineno(0)
+{
+    for (int i = 0; i < 4; i++)
+        count[i] = 0;
+    buf.append(AST_CACHE_MAGIC, 8);
+    put_key(buf, key);
+    put_key(buf, 0);                    // the payload's hash, by finish()
+}
+
+void AstWriter::put(unsigned v)
+{
+    while (v >= 0x80) {
+        buf += (char) ((v & 0x7f) | 0x80);
+        v >>= 7;
+    }
+    buf += (char) v;
+}
+
+void AstWriter::put_table_symbol(int table, Symbol sym)
+{
+    std::vector<int> &idx = index[table];
+    int i = sym->get_index();
+    if (i >= (int) idx.size())
+        idx.resize(2 * i + 16, -1);
+    if (idx[i] >= 0) {
+        put(idx[i]);
+        return;
+    }
+    idx[i] = count[table]++;
+    put(idx[i]);
+    put(sym->get_len());
+    buf.append(sym->get_string(), sym->get_len());
+}
+
+void AstWriter::node(int code, tree_node *t)
+{
+    int delta = t->get_line_number() - lineno;
+    lineno = t->get_line_number();
+    put(code);
+    put(delta >= 0 ? 2 * (unsigned) delta : 2 * (unsigned) -delta - 1);
+}
+
+void AstWriter::expr(int code, Expr_class *e)
+{
+    node(code, e);
+    maybe_id(e->getType());
+}
+
+void AstWriter::maybe_id(Symbol sym)
+{
+    put(sym != NULL);
+    if (sym != NULL)
+        id(sym);
+}
+
+void AstWriter::binding(const Binding &b)
+{
+    put(b.kind);
+    put(b.slot);
+    maybe_id(b.type);
+}
+
+bool AstWriter::finish()
+{
+    std::string hash;
+    put_key(hash, payload_hash(buf.data(), buf.size()));
+    buf.replace(16, 8, hash);
+    return fwrite(buf.data(), 1, buf.size(), out) == buf.size() &&
+        fflush(out) == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// The nodes.  Lists are written as their length and then the elements.
+//
+///////////////////////////////////////////////////////////////////////////
+
+void Program_class::save(AstWriter &out)
+{
+    out.node(AST_PROGRAM, this);
+    out.put(decls->len());
+    for (int i = decls->first(); decls->more(i); i = decls->next(i))
+        decls->nth(i)->save(out);
+}
+
+void Variable_class::save(AstWriter &out)
+{
+    out.node(AST_VARIABLE, this);
+    out.id(type);
+    out.id(name);
+}
+
+void VariableDecl_class::save(AstWriter &out)
+{
+    out.node(AST_VARIABLEDECL, this);
+    variable->save(out);
+}
+
+void CallDecl_class::save(AstWriter &out)
+{
+    out.node(AST_CALLDECL, this);
+    out.id(name);
+    out.put(paras->len());
+    for (int i = paras->first(); paras->more(i); i = paras->next(i))
+        paras->nth(i)->save(out);
+    out.id(returnType);
+    body->save(out);
+    out.put(locals);
+}
+
+void StmtBlock_class::save(AstWriter &out)
+{
+    out.node(AST_STMTBLOCK, this);
+    out.put(vars->len());
+    for (int i = vars->first(); vars->more(i); i = vars->next(i))
+        vars->nth(i)->save(out);
+    out.put(stmts->len());
+    for (int i = stmts->first(); stmts->more(i); i = stmts->next(i))
+        stmts->nth(i)->save(out);
+}
+
+void IfStmt_class::save(AstWriter &out)
+{
+    out.node(AST_IFSTMT, this);
+    condition->save(out);
+    thenexpr->save(out);
+    elseexpr->save(out);
+}
+
+void WhileStmt_class::save(AstWriter &out)
+{
+    out.node(AST_WHILESTMT, this);
+    condition->save(out);
+    body->save(out);
+}
+
+void ForStmt_class::save(AstWriter &out)
+{
+    out.node(AST_FORSTMT, this);
+    initexpr->save(out);
+    condition->save(out);
+    loopact->save(out);
+    body->save(out);
+}
+
+void ReturnStmt_class::save(AstWriter &out)
+{
+    out.node(AST_RETURNSTMT, this);
+    value->save(out);
+}
+
+void ContinueStmt_class::save(AstWriter &out)
+{
+    out.node(AST_CONTINUESTMT, this);
+}
+
+void BreakStmt_class::save(AstWriter &out)
+{
+    out.node(AST_BREAKSTMT, this);
+}
+
+void Assign_class::save(AstWriter &out)
+{
+    out.expr(AST_ASSIGN, this);
+    out.id(lvalue);
+    value->save(out);
+    out.binding(binding);
+}
+
+#define SAVE_BINARY(CLASS, CODE) \
+void CLASS::save(AstWriter &out) \
+{ \
+    out.expr(CODE, this); \
+    e1->save(out); \
+    e2->save(out); \
+}
+
+#define SAVE_UNARY(CLASS, CODE) \
+void CLASS::save(AstWriter &out) \
+{ \
+    out.expr(CODE, this); \
+    e1->save(out); \
+}
+
+SAVE_BINARY(Add_class, AST_ADD)
+SAVE_BINARY(Minus_class, AST_MINUS)
+SAVE_BINARY(Multi_class, AST_MULTI)
+SAVE_BINARY(Divide_class, AST_DIVIDE)
+SAVE_BINARY(Mod_class, AST_MOD)
+SAVE_UNARY(Neg_class, AST_NEG)
+SAVE_BINARY(Lt_class, AST_LT)
+SAVE_BINARY(Le_class, AST_LE)
+SAVE_BINARY(Equ_class, AST_EQU)
+SAVE_BINARY(Neq_class, AST_NEQ)
+SAVE_BINARY(Ge_class, AST_GE)
+SAVE_BINARY(Gt_class, AST_GT)
+SAVE_BINARY(And_class, AST_AND)
+SAVE_BINARY(Or_class, AST_OR)
+SAVE_BINARY(Xor_class, AST_XOR)
+SAVE_UNARY(Not_class, AST_NOT)
+SAVE_BINARY(Bitand_class, AST_BITAND)
+SAVE_BINARY(Bitor_class, AST_BITOR)
+SAVE_UNARY(Bitnot_class, AST_BITNOT)
+
+void Object_class::save(AstWriter &out)
+{
+    out.expr(AST_OBJECT, this);
+    out.id(var);
+    out.binding(binding);
+}
+
+void Call_class::save(AstWriter &out)
+{
+    out.expr(AST_CALL, this);
+    out.id(name);
+    out.put(actuals->len());
+    for (int i = actuals->first(); actuals->more(i); i = actuals->next(i))
+        actuals->nth(i)->save(out);
+}
+
+void Actual_class::save(AstWriter &out)
+{
+    out.expr(AST_ACTUAL, this);
+    expr->save(out);
+}
+
+void Const_int_class::save(AstWriter &out)
+{
+    out.expr(AST_CONST_INT, this);
+    out.int_const(value);
+}
+
+void Const_string_class::save(AstWriter &out)
+{
+    out.expr(AST_CONST_STRING, this);
+    out.string_const(value);
+}
+
+void Const_float_class::save(AstWriter &out)
+{
+    out.expr(AST_CONST_FLOAT, this);
+    out.float_const(value);
+}
+
+void Const_bool_class::save(AstWriter &out)
+{
+    out.expr(AST_CONST_BOOL, this);
+    out.put(value != 0);
+}
+
+void No_expr_class::save(AstWriter &out)
+{
+    out.expr(AST_NO_EXPR, this);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AstReader
+//
+//   The nodes are built with the constructors the parser uses, with
+//   node_lineno set to the line read, and the types and bindings set on
+//   them afterwards.  A node's fields are read before it is built, so
+//   its line is kept and set again just before.
+//
+///////////////////////////////////////////////////////////////////////////
+
+AstReader::AstReader(const char *data, size_t n)
+    : at((const unsigned char *) data), end((const unsigned char *) data + n),
+      lineno(0), bad(false)
+{
+}
+
+unsigned AstReader::get()
+{
+    unsigned v = 0;
+    for (int shift = 0; shift < 32 && !bad; shift += 7) {
+        if (at == end)
+            break;
+        int c = *at++;
+        v |= (unsigned) (c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return v;
+    }
+    bad = true;
+    return 0;
+}
+
+Symbol AstReader::get_symbol(int kind)
+{
+    std::vector<Symbol> &t = table[kind];
+    unsigned i = get();
+    if (i < t.size())
+        return t[i];
+    unsigned len = get();
+    if (i > t.size() || len > (size_t) (end - at) || bad) {
+        bad = true;
+        return idtable.add_string((char *) "");
+    }
+
+    std::string str((const char *) at, len);    // add_string wants a NUL
+    char *s = &str[0];
+    at += len;
+    Symbol sym;
+    switch (kind) {
+    case ID_TABLE:     sym = idtable.add_string(s, len); break;
+    case INT_TABLE:    sym = inttable.add_string(s, len); break;
+    case FLOAT_TABLE:  sym = floattable.add_string(s, len); break;
+    default:           sym = stringtable.add_string(s, len); break;
+    }
+    t.push_back(sym);
+    return sym;
+}
+
+Symbol AstReader::get_maybe_id()
+{
+    return get() != 0 ? get_symbol(ID_TABLE) : NULL;
+}
+
+Binding AstReader::get_binding()
+{
+    Binding b;
+    b.kind = get();
+    b.slot = get();
+    b.type = get_maybe_id();
+    return b;
+}
+
+int AstReader::start()
+{
+    int code = get();
+    unsigned delta = get();
+    lineno += delta & 1 ? -(int) (delta / 2) - 1 : (int) (delta / 2);
+    return code;
+}
+
+Variable AstReader::read_variable()
+{
+    if (start() != AST_VARIABLE) {
+        bad = true;
+        return NULL;
+    }
+    int line = lineno;
+    Symbol type = get_symbol(ID_TABLE);
+    Symbol name = get_symbol(ID_TABLE);
+    node_lineno = line;
+    return variable(type, name);
+}
+
+Decl AstReader::read_decl()
+{
+    int code = start();
+    int line = lineno;
+
+    if (code == AST_VARIABLEDECL) {
+        Variable v = read_variable();
+        node_lineno = line;
+        return variableDecl(v);
+    }
+    if (code != AST_CALLDECL) {
+        bad = true;
+        return NULL;
+    }
+
+    Symbol name = get_symbol(ID_TABLE);
+    Variables paras = nil_Variables();
+    for (unsigned n = get(); n > 0 && !bad; n--)
+        paras = add_Variables(paras, read_variable());
+    Symbol returnType = get_symbol(ID_TABLE);
+    StmtBlock body = read_block();
+    node_lineno = line;
+    CallDecl decl = callDecl(name, paras, returnType, body);
+    decl->locals = get();
+    calldecls.push_back(decl);
+    return decl;
+}
+
+StmtBlock AstReader::read_block()
+{
+    StmtBlock block = dynamic_cast<StmtBlock>(read_stmt());
+    if (block == NULL)
+        bad = true;
+    return block;
+}
+
+Stmt AstReader::read_stmt()
+{
+    int code = start();
+    int line = lineno;
+
+    switch (code) {
+    case AST_STMTBLOCK: {
+        VariableDecls vars = nil_VariableDecls();
+        for (unsigned n = get(); n > 0 && !bad; n--) {
+            VariableDecl decl = dynamic_cast<VariableDecl>(read_decl());
+            if (decl == NULL)
+                bad = true;
+            vars = add_VariableDecls(vars, decl);
+        }
+        Stmts stmts = nil_Stmts();
+        for (unsigned n = get(); n > 0 && !bad; n--)
+            stmts = add_Stmts(stmts, read_stmt());
+        node_lineno = line;
+        return stmtBlock(vars, stmts);
+    }
+    case AST_IFSTMT: {
+        Expr condition = read_expr();
+        StmtBlock thenexpr = read_block();
+        StmtBlock elseexpr = read_block();
+        node_lineno = line;
+        return ifstmt(condition, thenexpr, elseexpr);
+    }
+    case AST_WHILESTMT: {
+        Expr condition = read_expr();
+        StmtBlock body = read_block();
+        node_lineno = line;
+        return whilestmt(condition, body);
+    }
+    case AST_FORSTMT: {
+        Expr initexpr = read_expr();
+        Expr condition = read_expr();
+        Expr loopact = read_expr();
+        StmtBlock body = read_block();
+        node_lineno = line;
+        return forstmt(initexpr, condition, loopact, body);
+    }
+    case AST_RETURNSTMT: {
+        Expr value = read_expr();
+        node_lineno = line;
+        return returnstmt(value);
+    }
+    case AST_CONTINUESTMT:
+        node_lineno = line;
+        return continuestmt();
+    case AST_BREAKSTMT:
+        node_lineno = line;
+        return breakstmt();
+    }
+    return read_expr_rest(code, line);
+}
+
+Expr AstReader::read_expr()
+{
+    int code = start();
+    return read_expr_rest(code, lineno);
+}
+
+// an expression whose class and line have been read
+Expr AstReader::read_expr_rest(int code, int line)
+{
+    Symbol type = get_maybe_id();
+    Expr e = NULL;
+
+    switch (code) {
+    case AST_ASSIGN: {
+        Symbol lvalue = get_symbol(ID_TABLE);
+        Expr value = read_expr();
+        node_lineno = line;
+        Assign_class *a = (Assign_class *) assign(lvalue, value);
+        a->binding = get_binding();
+        e = a;
+        break;
+    }
+    case AST_ADD: case AST_MINUS: case AST_MULTI: case AST_DIVIDE:
+    case AST_MOD: case AST_LT: case AST_LE: case AST_EQU: case AST_NEQ:
+    case AST_GE: case AST_GT: case AST_AND: case AST_OR: case AST_XOR:
+    case AST_BITAND: case AST_BITOR: {
+        Expr e1 = read_expr();
+        Expr e2 = read_expr();
+        node_lineno = line;
+        switch (code) {
+        case AST_ADD:    e = add(e1, e2); break;
+        case AST_MINUS:  e = minus(e1, e2); break;
+        case AST_MULTI:  e = multi(e1, e2); break;
+        case AST_DIVIDE: e = divide(e1, e2); break;
+        case AST_MOD:    e = mod(e1, e2); break;
+        case AST_LT:     e = lt(e1, e2); break;
+        case AST_LE:     e = le(e1, e2); break;
+        case AST_EQU:    e = equ(e1, e2); break;
+        case AST_NEQ:    e = neq(e1, e2); break;
+        case AST_GE:     e = ge(e1, e2); break;
+        case AST_GT:     e = gt(e1, e2); break;
+        case AST_AND:    e = and_(e1, e2); break;
+        case AST_OR:     e = or_(e1, e2); break;
+        case AST_XOR:    e = xor_(e1, e2); break;
+        case AST_BITAND: e = bitand_(e1, e2); break;
+        default:         e = bitor_(e1, e2); break;
+        }
+        break;
+    }
+    case AST_NEG: case AST_NOT: case AST_BITNOT: {
+        Expr e1 = read_expr();
+        node_lineno = line;
+        e = code == AST_NEG ? neg(e1) : code == AST_NOT ? not_(e1) : bitnot(e1);
+        break;
+    }
+    case AST_OBJECT: {
+        Symbol var = get_symbol(ID_TABLE);
+        node_lineno = line;
+        Object o = (Object) object(var);
+        o->binding = get_binding();
+        e = o;
+        break;
+    }
+    case AST_CALL: {
+        Symbol name = get_symbol(ID_TABLE);
+        Actuals args = nil_Actuals();
+        for (unsigned n = get(); n > 0 && !bad; n--)
+            args = add_Actuals(args, read_actual());
+        node_lineno = line;
+        Call c = call(name, args);
+        calls.push_back(c);
+        e = c;
+        break;
+    }
+    case AST_ACTUAL: {
+        Expr expr = read_expr();
+        node_lineno = line;
+        e = actual(expr);
+        break;
+    }
+    case AST_CONST_INT: {
+        Symbol value = get_symbol(INT_TABLE);
+        node_lineno = line;
+        e = const_int(value);
+        break;
+    }
+    case AST_CONST_STRING: {
+        Symbol value = get_symbol(STRING_TABLE);
+        node_lineno = line;
+        e = const_string(value);
+        break;
+    }
+    case AST_CONST_FLOAT: {
+        Symbol value = get_symbol(FLOAT_TABLE);
+        node_lineno = line;
+        e = const_float(value);
+        break;
+    }
+    case AST_CONST_BOOL: {
+        Boolean value = get() != 0;
+        node_lineno = line;
+        e = const_bool(value);
+        break;
+    }
+    case AST_NO_EXPR:
+        node_lineno = line;
+        e = no_expr();
+        break;
+    default:
+        bad = true;
+        return NULL;
+    }
+    e->setType(type);
+    return e;
+}
+
+Actual AstReader::read_actual()
+{
+    Actual a = dynamic_cast<Actual>(read_expr());
+    if (a == NULL)
+        bad = true;
+    return a;
+}
+
+Program AstReader::read()
+{
+    if (start() != AST_PROGRAM)
+        return NULL;
+    int line = lineno;
+
+    Decls decls = nil_Decls();
+    for (unsigned n = get(); n > 0 && !bad; n--)
+        decls = add_Decls(decls, read_decl());
+    if (bad || at != end)
+        return NULL;
+    node_lineno = line;
+    Program p = program(decls);
+
+    SymbolMap<CallDecl> functions;
+    for (size_t i = 0; i < calldecls.size(); i++)
+        functions.insert(calldecls[i]->getName(), calldecls[i]);
+    for (size_t i = 0; i < calls.size(); i++) {
+        CallDecl *callee = functions.lookup(calls[i]->getName());
+        calls[i]->callee = callee != NULL ? *callee : NULL;
+    }
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// The cache files
+//
+///////////////////////////////////////////////////////////////////////////
+
+static std::string cache_name(char *filename)
+{
+    return std::string(filename) + "ast";
+}
+
+Program load_ast(char *filename, unsigned long long key)
+{
+    FILE *in = fopen(cache_name(filename).c_str(), "r");
+    if (in == NULL)
+        return NULL;
+
+    std::string data;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof buf, in)) > 0)
+        data.append(buf, n);
+    fclose(in);
+
+    if (data.size() < AST_CACHE_HEADER ||
+        memcmp(data.data(), AST_CACHE_MAGIC, 8) != 0 ||
+        get_key(data.data() + 8) != key ||
+        get_key(data.data() + 16) != payload_hash(data.data(), data.size()))
+        return NULL;
+    return AstReader(data.data() + AST_CACHE_HEADER,
+                     data.size() - AST_CACHE_HEADER).read();
+}
+
+//
+// The file is written under another name and renamed when it is
+// complete, so that a reader never sees half of one.
+//
+bool save_ast(Program program, char *filename, unsigned long long key)
+{
+    std::string name = cache_name(filename);
+    std::string temp = name + ".tmp";
+    FILE *out = fopen(temp.c_str(), "w");
+    if (out == NULL)
+        return false;
+
+    AstWriter writer(out, key);
+    program->save(writer);
+    bool ok = writer.finish();
+    ok = fclose(out) == 0 && ok;
+    if (ok && rename(temp.c_str(), name.c_str()) == 0)
+        return true;
+    remove(temp.c_str());
+    return false;
+}
@@ -0,0 +1,143 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _ASTCACHE_H_
+#define _ASTCACHE_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: astcache.h
+//
+// Binary typed ASTs: the checked tree of a source file saved next to it,
+// so that an unchanged file is neither parsed nor checked again.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "seal-decl.h"
+#include "seal-stmt.h"
+#include "seal-expr.h"
+
+//
+// A file.sealast starts with a header of AST_CACHE_HEADER bytes: the 8
+// bytes of AST_CACHE_MAGIC, the 8-byte key of the source it was made
+// from and the 8-byte FNV-1a hash of the rest of the file, low byte
+// first.  A file whose rest does not hash to that was damaged after it
+// was written, and is not read.  The program follows as one node, and
+// each node as
+//
+//      varint  its class, one of the AST_* codes below
+//      varint  its line number, zigzag coded, less that of the node
+//              written before it
+//      type    expressions only: their type, as a symbol or none
+//      fields  in the order the class's constructor takes them
+//
+// A field that is a node is written as a node, and a list as the varint
+// number of elements and then the elements.  Varints and the string
+// tables are as in token streams (see seal-tokens.h): a symbol is its
+// index in the file's identifiers, integers, floats or strings, and an
+// index one past the end of the table adds the string that follows.
+// Where a symbol may be missing, as a type may, a varint 0 says so and
+// otherwise 1 and the symbol follow.
+//
+// What checking left in the tree besides the types follows the fields:
+// the binding of an Object or Assign (its kind and slot, and the type
+// as above) and the number of local slots of a CallDecl.  A Call's
+// callee is found by name when the tree is read.
+//
+#define AST_CACHE_MAGIC "SEALAST2"
+#define AST_CACHE_HEADER 24
+
+enum {
+    AST_PROGRAM = 1, AST_VARIABLE, AST_VARIABLEDECL, AST_CALLDECL,
+    AST_STMTBLOCK, AST_IFSTMT, AST_WHILESTMT, AST_FORSTMT, AST_RETURNSTMT,
+    AST_CONTINUESTMT, AST_BREAKSTMT,
+    AST_ASSIGN, AST_ADD, AST_MINUS, AST_MULTI, AST_DIVIDE, AST_MOD, AST_NEG,
+    AST_LT, AST_LE, AST_EQU, AST_NEQ, AST_GE, AST_GT, AST_AND, AST_OR,
+    AST_XOR, AST_NOT, AST_BITAND, AST_BITOR, AST_BITNOT,
+    AST_OBJECT, AST_CALL, AST_ACTUAL, AST_CONST_INT, AST_CONST_STRING,
+    AST_CONST_FLOAT, AST_CONST_BOOL, AST_NO_EXPR
+};
+
+//
+// The key of a source: a 64-bit FNV-1a hash of its bytes.  Reads all of
+// in, and seeks back to where it was.  0, for no key, if in cannot seek,
+// as a pipe cannot, or cannot be read: it is then compiled without the
+// cache.
+//
+unsigned long long ast_cache_key(FILE *in);
+
+//
+// AstWriter writes a tree to out.  The nodes' save() methods call its
+// node() with their class, then write their fields with the rest.
+//
+class AstWriter {
+private:
+    FILE *out;
+    std::string buf;                    // what is written, until finish()
+    int lineno;                         // line of the last node written
+    std::vector<int> index[4];          // file index of each table entry,
+                                        // by its own index, or -1
+    int count[4];                       // entries written to each table
+
+    void put_table_symbol(int table, Symbol sym);
+public:
+    AstWriter(FILE *out, unsigned long long key);
+    void put(unsigned v);
+    void node(int code, tree_node *t);
+    void expr(int code, Expr_class *e); // node() and the type
+    void id(Symbol sym) { put_table_symbol(0, sym); }
+    void int_const(Symbol sym) { put_table_symbol(1, sym); }
+    void float_const(Symbol sym) { put_table_symbol(2, sym); }
+    void string_const(Symbol sym) { put_table_symbol(3, sym); }
+    void maybe_id(Symbol sym);          // an identifier or NULL
+    void binding(const Binding &b);
+    bool finish();                      // false if the file was not written
+};
+
+//
+// AstReader reads a tree back.  Any fault in the file makes read()
+// return NULL, and the caller compiles the source instead.
+//
+class AstReader {
+private:
+    const unsigned char *at, *end;      // what is left to read
+    int lineno;
+    bool bad;                           // the file is short or malformed
+    std::vector<Symbol> table[4];
+    std::vector<Call> calls;            // to point at their callees
+    std::vector<CallDecl> calldecls;
+
+    unsigned get();
+    Symbol get_symbol(int table);
+    Symbol get_maybe_id();
+    Binding get_binding();
+    int start();                        // read a node's class and line
+    Decl read_decl();
+    Variable read_variable();
+    StmtBlock read_block();
+    Stmt read_stmt();
+    Expr read_expr();
+    Expr read_expr_rest(int code, int line);
+    Actual read_actual();
+public:
+    // the bytes after the header
+    AstReader(const char *data, size_t n);
+    Program read();
+};
+
+extern int ast_cache;        // -a: load and save typed ASTs in file.sealast
+
+//
+// The typed AST of filename if its .sealast was made from a source with
+// this key and is intact, or NULL; and save that of a checked program.
+//
+Program load_ast(char *filename, unsigned long long key);
+bool save_ast(Program program, char *filename, unsigned long long key);
+
+#endif
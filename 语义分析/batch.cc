@@ -0,0 +1,127 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: batch.cc
+//
+// Compiles many input files on a pool of worker processes and writes
+// their output in input order.  See batch.h.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+#include "seal-io.h"
+#include "batch.h"
+
+struct BatchFile {
+    pid_t pid;       // the worker compiling the file
+    FILE *out, *err; // the worker's captured stdout and stderr
+    bool done;       // the worker has exited
+    int status;      // its wait status
+};
+
+//
+// Start a worker that compiles filename with its output captured in f.
+//
+static void start_worker(BatchFile &f, char *filename, compile_function compile)
+{
+    f.out = tmpfile();
+    f.err = tmpfile();
+    if (f.out == NULL || f.err == NULL) {
+        perror("batch: tmpfile");
+        exit(1);
+    }
+    f.done = false;
+
+    // anything still buffered would otherwise be written by the child too
+    cout.flush();
+    cerr.flush();
+    fflush(stdout);
+    fflush(stderr);
+
+    f.pid = fork();
+    if (f.pid < 0) {
+        perror("batch: fork");
+        exit(1);
+    }
+    if (f.pid == 0) {
+        dup2(fileno(f.out), 1);
+        dup2(fileno(f.err), 2);
+        int rc = compile(filename);
+        cout.flush();
+        cerr.flush();
+        exit(rc);
+    }
+}
+
+//
+// Copy a captured stream to "to" and close it.
+//
+static void copy_output(FILE *from, FILE *to)
+{
+    char buf[BUFSIZ];
+    size_t n;
+
+    rewind(from);
+    while ((n = fread(buf, 1, sizeof(buf), from)) > 0)
+        fwrite(buf, 1, n, to);
+    fclose(from);
+}
+
+int compile_batch(int nfiles, char *files[], int jobs, compile_function compile)
+{
+    std::vector<BatchFile> f(nfiles);
+    int started = 0, running = 0, written = 0, failed = 0;
+
+    if (jobs <= 0)
+        jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    if (jobs <= 0)
+        jobs = 1;
+
+    while (written < nfiles) {
+        while (running < jobs && started < nfiles) {
+            start_worker(f[started], files[started], compile);
+            started++;
+            running++;
+        }
+
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) {
+            perror("batch: wait");
+            exit(1);
+        }
+        for (int i = written; i < started; i++)
+            if (f[i].pid == pid && !f[i].done) {
+                f[i].done = true;
+                f[i].status = status;
+                running--;
+                break;
+            }
+
+        // write every finished file whose predecessors are all written
+        while (written < started && f[written].done) {
+            BatchFile &w = f[written];
+            fflush(stdout);
+            copy_output(w.out, stdout);
+            fflush(stdout);
+            fseek(w.err, 0, SEEK_END);
+            if (ftell(w.err) > 0)
+                fprintf(stderr, "%s:\n", files[written]);
+            copy_output(w.err, stderr);
+            if (!WIFEXITED(w.status) || WEXITSTATUS(w.status) != 0)
+                failed++;
+            written++;
+        }
+    }
+    fflush(stdout);
+    return failed;
+}
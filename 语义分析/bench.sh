@@ -0,0 +1,38 @@
+#!/bin/bash
+# 用字节码虚拟机（-x）运行bench/中的SEAL程序，再用-o编译成本机程序运行：
+# 不分配寄存器（-r）、分配寄存器、再加-O，报告墙钟时间及溢出到栈上的
+# 寄存器数
+# 用法: ./bench.sh [重复次数]
+# 每个程序运行若干次（默认三次）取最快的一次；先用make semant编译。
+times=${1:-3}
+
+run() {
+    best=
+    for ((i = 0; i < times; i++)); do
+        start=$(date +%s.%N)
+        "$@" > /dev/null
+        end=$(date +%s.%N)
+        best=$(awk -v s=$start -v e=$end -v b="$best" \
+            'BEGIN { t = e - s; if (b != "" && b < t) t = b; print t }')
+    done
+    echo $best
+}
+
+out=$(mktemp)
+printf "%-10s %10s %10s %10s %10s %8s\n" program "vm (s)" "-r (s)" "native (s)" "-O (s)" spilled
+for program in bench/*.seal; do
+    name=$(basename $program .seal)
+    ./semant -x $program > /dev/null || exit 1
+    vm=$(run ./semant -x $program)
+    ./semant -r -o $out $program || exit 1
+    slots=$(run $out)
+    ./semant -o $out $program || exit 1
+    native=$(run $out)
+    ./semant -O -o $out $program || exit 1
+    optimized=$(run $out)
+    # -c写出的汇编里每个函数注明溢出的寄存器数
+    ./semant -c -o $out.s $program || exit 1
+    spilled=$(awk '/ spilled$/ { n += $(NF - 1) } END { print n + 0 }' $out.s)
+    printf "%-10s %10.3f %10.3f %10.3f %10.3f %8d\n" $name $vm $slots $native $optimized $spilled
+done
+rm -f $out $out.s
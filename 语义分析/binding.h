@@ -0,0 +1,106 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _BINDING_H_
+#define _BINDING_H_
+
+#include <vector>
+#include "stringtab.h"
+
+//
+// What a variable name refers to, as the checker resolves it: a global,
+// the slot-th parameter of the function, or its slot-th local variable,
+// with the variable's type.  Globals and locals are numbered in the
+// order they are declared, from 0.
+//
+const int unboundbinding = 0;
+const int globalbinding = 1;
+const int parameterbinding = 2;
+const int localbinding = 3;
+
+struct Binding {
+    int kind;
+    int slot;
+    Symbol type;
+};
+
+//
+// BindingTable: the variables in scope while the checker runs, as a
+// stack of scopes.
+//
+//    Every identifier is interned with a unique index, so the innermost
+//    binding of each name is kept in an array indexed by the name's
+//    Entry index: a lookup is one array access.  The bindings themselves
+//    are on an undo log, each with the log position of the binding it
+//    shadows, and leaving a scope pops its bindings and restores those.
+//
+//    `enterscope()' and `exitscope()' open and close a scope.
+//
+//    `addid(s,b)' binds `s' to `b' in the innermost scope.
+//
+//    `lookup(s)' returns the innermost binding of `s', or NULL.  The
+//        pointer is good until the next addid.
+//
+//    `probe(s)' does the same, but for the innermost scope only.
+//
+class BindingTable {
+private:
+    struct Bound {
+        Symbol name;
+        Binding binding;
+        int shadowed;                   // undo log position, or -1
+    };
+    std::vector<int> innermost;         // by name index: undo log position, or -1
+    std::vector<Bound> undo;            // the bindings, oldest first
+    std::vector<size_t> scopes;         // undo.size() when each was entered
+
+    BindingTable(const BindingTable &);             // not copyable
+    BindingTable &operator =(const BindingTable &);
+
+    int position(Symbol s) const
+    {
+        int i = s->get_index();
+        return i < (int) innermost.size() ? innermost[i] : -1;
+    }
+public:
+    BindingTable() { }
+
+    void enterscope() { scopes.push_back(undo.size()); }
+
+    void exitscope()
+    {
+        while (undo.size() > scopes.back()) {
+            Bound &e = undo.back();
+            innermost[e.name->get_index()] = e.shadowed;
+            undo.pop_back();
+        }
+        scopes.pop_back();
+    }
+
+    void addid(Symbol s, Binding b)
+    {
+        int i = s->get_index();
+        if (i >= (int) innermost.size())
+            innermost.resize(2 * i + 16, -1);
+        Bound e = { s, b, innermost[i] };
+        innermost[i] = undo.size();
+        undo.push_back(e);
+    }
+
+    Binding *lookup(Symbol s)
+    {
+        int p = position(s);
+        return p >= 0 ? &undo[p].binding : NULL;
+    }
+
+    Binding *probe(Symbol s)
+    {
+        int p = position(s);
+        return p >= 0 && p >= (int) scopes.back() ? &undo[p].binding : NULL;
+    }
+};
+
+#endif
@@ -0,0 +1,728 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: bytecode.cc
+//
+// The compiler from the typed AST to bytecode: the code() methods of
+// the nodes.  It runs only on checked programs, so it trusts the types
+// the checker left in the tree; the few mistakes the checker lets
+// through (a String added to an Int, say) are reported here.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string>
+#include "bytecode.h"
+
+#define BYTECODE_NAME(name) #name,
+const char *opcode_names[OP_COUNT] = { BYTECODE_OPS(BYTECODE_NAME) };
+#undef BYTECODE_NAME
+
+BytecodeGen::BytecodeGen(Bytecode &p) : program(p)
+{
+    function = NULL;
+    errors = 0;
+    program.globals = 0;
+    program.main = -1;
+    Int = idtable.add_string("Int");
+    Float = idtable.add_string("Float");
+    String = idtable.add_string("String");
+    Bool = idtable.add_string("Bool");
+    Void = idtable.add_string("Void");
+    print = idtable.add_string("printf");
+}
+
+int BytecodeGen::emit(tree_node *t, int op, int a, int b, int c)
+{
+    Insn insn = { op, a, b, c };
+    function->code.push_back(insn);
+    function->lines.push_back(t != NULL ? t->get_line_number() : 0);
+    return function->code.size() - 1;
+}
+
+int BytecodeGen::move(tree_node *t, int dst, int r)
+{
+    if (dst < 0 || dst == r)
+        return r;
+    emit(t, OP_MOV, dst, r);
+    return dst;
+}
+
+int BytecodeGen::int_const(Symbol sym)
+{
+    int *found = ints.lookup(sym);
+    if (found != NULL)
+        return *found;
+    program.ints.push_back((long long) strtoull(sym->get_string(), NULL, 10));
+    ints.insert(sym, program.ints.size() - 1);
+    return program.ints.size() - 1;
+}
+
+int BytecodeGen::float_const(Symbol sym)
+{
+    int *found = floats.lookup(sym);
+    if (found != NULL)
+        return *found;
+    program.floats.push_back(strtod(sym->get_string(), NULL));
+    floats.insert(sym, program.floats.size() - 1);
+    return program.floats.size() - 1;
+}
+
+int BytecodeGen::string_const(Symbol sym)
+{
+    int *found = strings.lookup(sym);
+    if (found != NULL)
+        return *found;
+    program.strings.push_back(sym->get_string());
+    strings.insert(sym, program.strings.size() - 1);
+    return program.strings.size() - 1;
+}
+
+int BytecodeGen::reg(const Binding &b)
+{
+    switch (b.kind) {
+    case parameterbinding:
+        return b.slot;
+    case localbinding:
+        return function->params + b.slot;
+    default:
+        return -1;
+    }
+}
+
+bool BytecodeGen::numbers(tree_node *t, Expr e1, int &a, Expr e2, int &b)
+{
+    Symbol t1 = e1->getType(), t2 = e2->getType();
+    if ((t1 != Int && t1 != Float) || (t2 != Int && t2 != Float))
+        return false;
+    a = e1->code_value(*this, -1);
+    b = e2->code_value(*this, -1);
+    if (t1 == Int && t2 == Float) {
+        int f = temp();
+        emit(t, OP_I2F, f, a);
+        a = f;
+    } else if (t1 == Float && t2 == Int) {
+        int f = temp();
+        emit(t, OP_I2F, f, b);
+        b = f;
+    }
+    return true;
+}
+
+void BytecodeGen::exit_loop(int end, int next)
+{
+    Loop &loop = loops.back();
+    for (size_t i = 0; i < loop.breaks.size(); i++)
+        patch(loop.breaks[i], end);
+    for (size_t i = 0; i < loop.continues.size(); i++)
+        patch(loop.continues[i], next);
+    loops.pop_back();
+}
+
+ostream &BytecodeGen::error(tree_node *t)
+{
+    errors++;
+    return cerr << t->get_line_number() << ": ";
+}
+
+//
+// An Int constant that fits in an instruction, as LOADI's b and the
+// immediate operands want it.
+//
+static bool small_int(Expr e, int &v)
+{
+    Const_int_class *k = dynamic_cast<Const_int_class *>(e);
+    if (k == NULL)
+        return false;
+    long long n = (long long) strtoull(k->getValue()->get_string(), NULL, 10);
+    if (n < -2147483647 - 1 || n > 2147483647)
+        return false;
+    v = (int) n;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Declarations.  Every function gets its index first, so calls know
+// where they go before their callee is compiled.
+//
+///////////////////////////////////////////////////////////////////////////
+
+void Program_class::code(BytecodeGen &g)
+{
+    for (int i = decls->first(); decls->more(i); i = decls->next(i)) {
+        Decl decl = decls->nth(i);
+        if (!decl->isCallDecl())
+            continue;
+        CallDecl calldecl = (CallDecl) decl;
+        BytecodeFunction f;
+        f.name = calldecl->getName();
+        f.returnType = calldecl->getType();
+        f.params = calldecl->getVariables()->len();
+        f.locals = calldecl->locals;
+        f.regs = f.params + f.locals;
+        if (f.name == idtable.add_string("main"))
+            g.program.main = g.program.functions.size();
+        g.functions.insert(f.name, g.program.functions.size());
+        g.program.functions.push_back(f);
+    }
+    for (int i = decls->first(); decls->more(i); i = decls->next(i))
+        decls->nth(i)->code(g);
+}
+
+void VariableDecl_class::code(BytecodeGen &g)
+{
+    g.program.globals++;
+}
+
+void CallDecl_class::code(BytecodeGen &g)
+{
+    g.function = &g.program.functions[*g.functions.lookup(name)];
+
+    // the locals start out as 0, 0.0, false and ""
+    VariableDecls vars = body->getVariableDecls();
+    for (int i = vars->first(); vars->more(i); i = vars->next(i)) {
+        int r = g.function->params + i;
+        if (vars->nth(i)->getType() == g.String)
+            g.emit(vars->nth(i), OP_LOADS, r,
+                   g.string_const(stringtable.add_string("")));
+        else
+            g.emit(vars->nth(i), OP_LOADI, r, 0);
+    }
+    body->code(g);
+    // only reached by falling off the end of a Void function
+    g.emit(this, OP_RETV, 0);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Statements.  Loops test at the bottom, so an iteration takes one jump:
+//
+//          JMP test
+//    body: ...                   continue jumps to next
+//    next: (for: the loop action)
+//    test: jump to body if the condition holds
+//    end:                        break jumps here
+//
+///////////////////////////////////////////////////////////////////////////
+
+void StmtBlock_class::code(BytecodeGen &g)
+{
+    // the checker puts no variables of inner blocks in scope, so there
+    // is nothing to do for vars
+    for (int i = stmts->first(); stmts->more(i); i = stmts->next(i))
+        stmts->nth(i)->code(g);
+}
+
+void IfStmt_class::code(BytecodeGen &g)
+{
+    std::vector<int> otherwise;
+    condition->code_branch(g, false, otherwise);
+    thenexpr->code(g);
+    if (elseexpr->is_empty()) {
+        for (size_t i = 0; i < otherwise.size(); i++)
+            g.patch(otherwise[i], g.here());
+        return;
+    }
+    int end = g.emit(this, OP_JMP, 0);
+    for (size_t i = 0; i < otherwise.size(); i++)
+        g.patch(otherwise[i], g.here());
+    elseexpr->code(g);
+    g.patch(end, g.here());
+}
+
+void WhileStmt_class::code(BytecodeGen &g)
+{
+    int test = g.emit(this, OP_JMP, 0);
+    int top = g.here();
+    g.enter_loop();
+    body->code(g);
+    int next = g.here();
+    g.patch(test, next);
+    std::vector<int> again;
+    condition->code_branch(g, true, again);
+    for (size_t i = 0; i < again.size(); i++)
+        g.patch(again[i], top);
+    g.exit_loop(g.here(), next);
+}
+
+void ForStmt_class::code(BytecodeGen &g)
+{
+    if (!initexpr->is_empty_Expr())
+        initexpr->code(g);
+    int test = g.emit(this, OP_JMP, 0);
+    int top = g.here();
+    g.enter_loop();
+    body->code(g);
+    int next = g.here();
+    if (!loopact->is_empty_Expr())
+        loopact->code(g);
+    g.patch(test, g.here());
+    if (condition->is_empty_Expr()) {
+        g.emit(this, OP_JMP, 0, 0, top);
+    } else {
+        std::vector<int> again;
+        condition->code_branch(g, true, again);
+        for (size_t i = 0; i < again.size(); i++)
+            g.patch(again[i], top);
+    }
+    g.exit_loop(g.here(), next);
+}
+
+void ReturnStmt_class::code(BytecodeGen &g)
+{
+    if (value->is_empty_Expr()) {
+        g.emit(this, OP_RETV, 0);
+        return;
+    }
+    int r = value->code_value(g, -1);
+    if (value->getType() == g.Void)
+        g.emit(this, OP_RETV, 0);
+    else
+        g.emit(this, OP_RET, r);
+}
+
+void ContinueStmt_class::code(BytecodeGen &g)
+{
+    g.add_continue(g.emit(this, OP_JMP, 0));
+}
+
+void BreakStmt_class::code(BytecodeGen &g)
+{
+    g.add_break(g.emit(this, OP_JMP, 0));
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Expressions
+//
+///////////////////////////////////////////////////////////////////////////
+
+//
+// Any Bool expression can be tested by computing it; comparisons and the
+// logical operators do better.
+//
+void Expr_class::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps)
+{
+    int r = code_value(g, -1);
+    jumps.push_back(g.emit(this, when ? OP_JT : OP_JF, r));
+}
+
+// the value of a test: false, unless it holds
+static int branch_value(BytecodeGen &g, Expr e, int dst)
+{
+    int r = g.temp();
+    std::vector<int> no;
+    g.emit(e, OP_LOADI, r, 0);
+    e->code_branch(g, false, no);
+    g.emit(e, OP_LOADI, r, 1);
+    for (size_t i = 0; i < no.size(); i++)
+        g.patch(no[i], g.here());
+    return g.move(e, dst, r);
+}
+
+int Call_class::code_value(BytecodeGen &g, int dst)
+{
+    int n = actuals->len();
+    int base = g.temps(n);
+    std::string types;
+    for (int i = actuals->first(); actuals->more(i); i = actuals->next(i)) {
+        Actual actual = actuals->nth(i);
+        Symbol type = actual->getType();
+        actual->code_value(g, base + i);
+        types += type == g.Float ? 'f' : type == g.String ? 's' :
+                 type == g.Bool ? 'b' : 'i';
+        if (type == g.Void)
+            g.error(this) << "Argument " << (i + 1) << " of " << name
+                          << " has no value.\n";
+    }
+    if (name == g.print) {
+        Symbol letters = stringtable.add_string((char *) types.c_str());
+        g.emit(this, OP_PRINTF, base, n, g.string_const(letters));
+        return -1;
+    }
+    int *f = g.functions.lookup(name);
+    if (f == NULL) {
+        g.error(this) << "Function " << name << " has not been defined.\n";
+        return -1;
+    }
+    int r = g.target(dst);
+    g.emit(this, OP_CALL, r, *f, base);
+    return type == g.Void ? -1 : r;
+}
+
+int Actual_class::code_value(BytecodeGen &g, int dst)
+{
+    return expr->code_value(g, dst);
+}
+
+int Assign_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.reg(binding);
+    if (r >= 0) {
+        value->code_value(g, r);
+        return g.move(this, dst, r);
+    }
+    r = value->code_value(g, -1);
+    g.emit(this, OP_SETG, binding.slot, r);
+    return g.move(this, dst, r);
+}
+
+//
+// + - * /: Ints, or Floats if either operand is one.  An Int constant
+// added or subtracted goes into the instruction.
+//
+static int arithmetic(BytecodeGen &g, Expr e, const char *what,
+                      int op, int floatop, Expr e1, Expr e2, int dst)
+{
+    int a, b, k;
+    if (e->getType() == g.Int && e1->getType() == g.Int && e2->getType() == g.Int
+            && (op == OP_ADD || op == OP_SUB) && small_int(e2, k)
+            && k != -2147483647 - 1) {
+        a = e1->code_value(g, -1);
+        int r = g.target(dst);
+        g.emit(e, OP_ADDI, r, a, op == OP_ADD ? k : -k);
+        return r;
+    }
+    if (!g.numbers(e, e1, a, e2, b)) {
+        g.error(e) << "Operation " << what << " is only used for numbers.\n";
+        return g.target(dst);
+    }
+    int r = g.target(dst);
+    bool floats = e1->getType() == g.Float || e2->getType() == g.Float;
+    g.emit(e, floats ? floatop : op, r, a, b);
+    return r;
+}
+
+int Add_class::code_value(BytecodeGen &g, int dst)
+{
+    return arithmetic(g, this, "+", OP_ADD, OP_ADDF, e1, e2, dst);
+}
+
+int Minus_class::code_value(BytecodeGen &g, int dst)
+{
+    return arithmetic(g, this, "-", OP_SUB, OP_SUBF, e1, e2, dst);
+}
+
+int Multi_class::code_value(BytecodeGen &g, int dst)
+{
+    return arithmetic(g, this, "*", OP_MUL, OP_MULF, e1, e2, dst);
+}
+
+int Divide_class::code_value(BytecodeGen &g, int dst)
+{
+    return arithmetic(g, this, "/", OP_DIV, OP_DIVF, e1, e2, dst);
+}
+
+// the Int operation op of e1 and e2, which the checker made sure of
+static int ints(BytecodeGen &g, Expr e, int op, Expr e1, Expr e2, int dst)
+{
+    int a = e1->code_value(g, -1);
+    int b = e2->code_value(g, -1);
+    int r = g.target(dst);
+    g.emit(e, op, r, a, b);
+    return r;
+}
+
+int Mod_class::code_value(BytecodeGen &g, int dst)
+{
+    return ints(g, this, OP_MOD, e1, e2, dst);
+}
+
+int Neg_class::code_value(BytecodeGen &g, int dst)
+{
+    int a = e1->code_value(g, -1);
+    int r = g.target(dst);
+    g.emit(this, e1->getType() == g.Float ? OP_NEGF : OP_NEG, r, a);
+    return r;
+}
+
+//
+// Comparisons.  Ints and Bools are tested with one jump, and against a
+// small constant with one that holds it; Floats and Strings are compared
+// into a register first, since "not less" is not "greater or equal" for
+// a Float that is NaN.
+//
+enum Relation { LT, LE, GT, GE, EQ, NE };
+
+static const Relation swapped[] = { GT, GE, LT, LE, EQ, NE };   // b r a
+static const Relation negated[] = { GE, GT, LE, LT, NE, EQ };   // !(a r b)
+
+// the compare op of a relation with the operands in order (LT, LE, EQ
+// or NE, by kind); true if the operands go the other way
+static bool compare_op(Relation rel, int lt, int &op)
+{
+    static const int offset[] = { 0, 1, 0, 1, 2, 3 };
+    op = lt + offset[rel];
+    return rel == GT || rel == GE;
+}
+
+//
+// The kind of comparison of e1 and e2: 'i' for Ints and Bools, 'f' for
+// numbers where one is a Float, 's' for Strings, or 0 if they cannot be
+// compared.
+//
+static char compare_kind(BytecodeGen &g, Expr e1, Expr e2)
+{
+    Symbol t1 = e1->getType(), t2 = e2->getType();
+    bool n1 = t1 == g.Int || t1 == g.Float, n2 = t2 == g.Int || t2 == g.Float;
+    if (n1 && n2)
+        return t1 == g.Float || t2 == g.Float ? 'f' : 'i';
+    if (t1 == g.Bool && t2 == g.Bool)
+        return 'i';
+    if (t1 == g.String && t2 == g.String)
+        return 's';
+    return 0;
+}
+
+static int compare_value(BytecodeGen &g, Expr e, Relation rel,
+                         Expr e1, Expr e2, int dst)
+{
+    int a, b, op;
+    switch (compare_kind(g, e1, e2)) {
+    case 'i':
+        a = e1->code_value(g, -1);
+        b = e2->code_value(g, -1);
+        if (compare_op(rel, OP_LT, op))
+            std::swap(a, b);
+        break;
+    case 'f':
+        g.numbers(e, e1, a, e2, b);
+        if (compare_op(rel, OP_LTF, op))
+            std::swap(a, b);
+        break;
+    case 's':
+        a = e1->code_value(g, -1);
+        b = e2->code_value(g, -1);
+        if (compare_op(rel, OP_LTS, op))
+            std::swap(a, b);
+        break;
+    default:
+        g.error(e) << "Can't compare " << e1->getType() << " and "
+                   << e2->getType() << ".\n";
+        return g.target(dst);
+    }
+    int r = g.target(dst);
+    g.emit(e, op, r, a, b);
+    return r;
+}
+
+static void compare_branch(BytecodeGen &g, Expr e, Relation rel, Expr e1,
+                           Expr e2, bool when, std::vector<int> &jumps)
+{
+    if (compare_kind(g, e1, e2) != 'i') {
+        int r = compare_value(g, e, rel, e1, e2, -1);
+        jumps.push_back(g.emit(e, when ? OP_JT : OP_JF, r));
+        return;
+    }
+    if (!when)
+        rel = negated[rel];
+    int k;
+    if (small_int(e1, k) && !small_int(e2, k)) {
+        std::swap(e1, e2);
+        rel = swapped[rel];
+    }
+    if (small_int(e2, k)) {
+        static const int immediate[] = {
+            OP_JLTI, OP_JLEI, OP_JGTI, OP_JGEI, OP_JEQI, OP_JNEI
+        };
+        int a = e1->code_value(g, -1);
+        jumps.push_back(g.emit(e, immediate[rel], a, k));
+        return;
+    }
+    int a = e1->code_value(g, -1);
+    int b = e2->code_value(g, -1);
+    int op;
+    if (compare_op(rel, OP_JLT, op))
+        std::swap(a, b);
+    jumps.push_back(g.emit(e, op, a, b));
+}
+
+#define COMPARISON(cls, rel) \
+int cls::code_value(BytecodeGen &g, int dst) \
+{ \
+    return compare_value(g, this, rel, e1, e2, dst); \
+} \
+\
+void cls::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps) \
+{ \
+    compare_branch(g, this, rel, e1, e2, when, jumps); \
+}
+
+COMPARISON(Lt_class, LT)
+COMPARISON(Le_class, LE)
+COMPARISON(Gt_class, GT)
+COMPARISON(Ge_class, GE)
+COMPARISON(Equ_class, EQ)
+COMPARISON(Neq_class, NE)
+
+//
+// && and || do not evaluate their right operand when the left one
+// decides.
+//
+int And_class::code_value(BytecodeGen &g, int dst)
+{
+    return branch_value(g, this, dst);
+}
+
+void And_class::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps)
+{
+    if (!when) {
+        e1->code_branch(g, false, jumps);
+        e2->code_branch(g, false, jumps);
+        return;
+    }
+    std::vector<int> no;
+    e1->code_branch(g, false, no);
+    e2->code_branch(g, true, jumps);
+    for (size_t i = 0; i < no.size(); i++)
+        g.patch(no[i], g.here());
+}
+
+int Or_class::code_value(BytecodeGen &g, int dst)
+{
+    return branch_value(g, this, dst);
+}
+
+void Or_class::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps)
+{
+    if (when) {
+        e1->code_branch(g, true, jumps);
+        e2->code_branch(g, true, jumps);
+        return;
+    }
+    std::vector<int> yes;
+    e1->code_branch(g, true, yes);
+    e2->code_branch(g, false, jumps);
+    for (size_t i = 0; i < yes.size(); i++)
+        g.patch(yes[i], g.here());
+}
+
+int Xor_class::code_value(BytecodeGen &g, int dst)
+{
+    return ints(g, this, OP_XOR, e1, e2, dst);
+}
+
+int Not_class::code_value(BytecodeGen &g, int dst)
+{
+    int a = e1->code_value(g, -1);
+    int r = g.target(dst);
+    g.emit(this, OP_NOT, r, a);
+    return r;
+}
+
+void Not_class::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps)
+{
+    e1->code_branch(g, !when, jumps);
+}
+
+int Bitnot_class::code_value(BytecodeGen &g, int dst)
+{
+    int a = e1->code_value(g, -1);
+    int r = g.target(dst);
+    g.emit(this, OP_BNOT, r, a);
+    return r;
+}
+
+int Bitand_class::code_value(BytecodeGen &g, int dst)
+{
+    return ints(g, this, OP_BAND, e1, e2, dst);
+}
+
+int Bitor_class::code_value(BytecodeGen &g, int dst)
+{
+    return ints(g, this, OP_BOR, e1, e2, dst);
+}
+
+int Const_int_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.target(dst), k;
+    if (small_int(this, k))
+        g.emit(this, OP_LOADI, r, k);
+    else
+        g.emit(this, OP_LOADK, r, g.int_const(value));
+    return r;
+}
+
+int Const_string_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.target(dst);
+    g.emit(this, OP_LOADS, r, g.string_const(value));
+    return r;
+}
+
+int Const_float_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.target(dst);
+    g.emit(this, OP_LOADF, r, g.float_const(value));
+    return r;
+}
+
+int Const_bool_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.target(dst);
+    g.emit(this, OP_LOADI, r, value ? 1 : 0);
+    return r;
+}
+
+void Const_bool_class::code_branch(BytecodeGen &g, bool when, std::vector<int> &jumps)
+{
+    if ((value != 0) == when)
+        jumps.push_back(g.emit(this, OP_JMP, 0));
+}
+
+int Object_class::code_value(BytecodeGen &g, int dst)
+{
+    int r = g.reg(binding);
+    if (r >= 0)
+        return g.move(this, dst, r);
+    r = g.target(dst);
+    g.emit(this, OP_GETG, r, binding.slot);
+    return r;
+}
+
+int No_expr_class::code_value(BytecodeGen &g, int dst)
+{
+    return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+Bytecode *compile_bytecode(Program program)
+{
+    Bytecode *code = new Bytecode;
+    BytecodeGen g(*code);
+    program->code(g);
+    if (g.errors > 0) {
+        cerr << "Compilation halted due to errors in code generation." << endl;
+        delete code;
+        return NULL;
+    }
+    return code;
+}
+
+//
+// -c: each function's instructions, one to a line, with their source
+// lines.
+//
+void Bytecode::dump(ostream &s)
+{
+    for (size_t f = 0; f < functions.size(); f++) {
+        BytecodeFunction &fn = functions[f];
+        s << f << ": " << fn.name << ", " << fn.params << " parameters, "
+          << fn.locals << " locals, " << fn.regs << " registers\n";
+        for (size_t i = 0; i < fn.code.size(); i++) {
+            Insn &insn = fn.code[i];
+            char line[80];
+            snprintf(line, sizeof line, "  %5d  %-6s %6d %6d %6d    # line %d\n",
+                     (int) i, opcode_names[insn.op], insn.a, insn.b, insn.c,
+                     fn.lines[i]);
+            s << line;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _BYTECODE_H_
+#define _BYTECODE_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: bytecode.h
+//
+// Register bytecode for checked SEAL programs: the instructions, the
+// compiler state the AST nodes' code() methods share, and the virtual
+// machine that runs it (vm.cc).
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "seal-decl.h"
+#include "seal-stmt.h"
+#include "seal-expr.h"
+#include "symmap.h"
+
+//
+// A function works on its own numbered registers: its parameters first,
+// then its local variables, then the temporaries the compiler makes,
+// one for every value it computes.  Each register holds a Value; which
+// member is in use is known from the instruction, since every type is
+// known when the program is compiled.  Bools are Ints 0 and 1, and
+// Strings point into the string table.
+//
+union Value {
+    long long i;
+    double f;
+    const char *s;
+};
+
+//
+// The instructions, each as OP(name) for the enum and its tables.  a, b
+// and c are registers unless the comment says otherwise; the result, if
+// any, goes to a.  A jump's target, the index of an instruction, is
+// always in c.  Comparisons of Floats and Strings end in F and S; the
+// others compare Ints.
+//
+#define BYTECODE_OPS(OP) \
+    OP(MOV)         /* a = b */ \
+    OP(LOADI)       /* a = the Int b */ \
+    OP(LOADK)       /* a = ints[b] */ \
+    OP(LOADF)       /* a = floats[b] */ \
+    OP(LOADS)       /* a = strings[b] */ \
+    OP(GETG)        /* a = global b */ \
+    OP(SETG)        /* global a = b */ \
+    OP(ADD) OP(SUB) OP(MUL) OP(DIV) OP(MOD) \
+    OP(ADDI)        /* a = b + the Int c */ \
+    OP(ADDF) OP(SUBF) OP(MULF) OP(DIVF) \
+    OP(NEG) OP(NEGF) \
+    OP(I2F)         /* a = b as a Float */ \
+    OP(BAND) OP(BOR) OP(BNOT) \
+    OP(NOT)         /* Bools */ \
+    OP(XOR) \
+    OP(LT) OP(LE) OP(EQ) OP(NE) \
+    OP(LTF) OP(LEF) OP(EQF) OP(NEF) \
+    OP(LTS) OP(LES) OP(EQS) OP(NES) \
+    OP(JMP)         /* to c */ \
+    OP(JT) OP(JF)   /* to c if a is true, false */ \
+    OP(JLT) OP(JLE) OP(JEQ) OP(JNE)         /* to c if a < b, ... */ \
+    OP(JLTI) OP(JLEI) OP(JGTI) OP(JGEI) OP(JEQI) OP(JNEI) \
+                    /* to c if a < the Int b, ... */ \
+    OP(CALL)        /* a = functions[b] of the registers from c on */ \
+    OP(PRINTF)      /* printf of the b registers from a on, their */ \
+                    /* types the letters of strings[c] */ \
+    OP(RET)         /* return a */ \
+    OP(RETV)        /* return nothing */
+
+#define BYTECODE_ENUM(name) OP_##name,
+enum Opcode { BYTECODE_OPS(BYTECODE_ENUM) OP_COUNT };
+#undef BYTECODE_ENUM
+
+extern const char *opcode_names[OP_COUNT];
+
+struct Insn {
+    int op, a, b, c;
+};
+
+//
+// A call copies nothing: the caller computes the arguments into
+// consecutive registers above every register it still needs, and the
+// callee's registers start at the first of them, so the arguments are
+// its parameters where they are.
+//
+struct BytecodeFunction {
+    Symbol name;
+    Symbol returnType;
+    int params;                       // registers 0 .. params-1
+    int locals;                       // then these
+    int regs;                         // in all
+    std::vector<Insn> code;
+    std::vector<int> lines;           // source line of each instruction
+};
+
+struct Bytecode {
+    std::vector<BytecodeFunction> functions;
+    std::vector<long long> ints;      // the constant pools
+    std::vector<double> floats;
+    std::vector<const char *> strings;
+    int globals;
+    int main;                         // index of main in functions
+
+    void dump(ostream &s);            // -c: a listing
+};
+
+//
+// What the code() methods share while one function is compiled.
+//
+class BytecodeGen {
+private:
+    struct Loop {
+        std::vector<int> breaks;        // jumps to the loop's end
+        std::vector<int> continues;     // and to where it goes on
+    };
+    std::vector<Loop> loops;
+    SymbolMap<int> ints, floats, strings;  // constant pool indexes
+public:
+    Bytecode &program;
+    BytecodeFunction *function;         // being compiled
+    SymbolMap<int> functions;           // index of each function, by name
+    Symbol Int, Float, String, Bool, Void, print;
+    int errors;
+
+    BytecodeGen(Bytecode &program);
+
+    int temp() { return function->regs++; }
+    int temps(int n) { int r = function->regs; function->regs += n; return r; }
+    int target(int dst) { return dst >= 0 ? dst : temp(); }
+    int move(tree_node *t, int dst, int r);     // r, into dst if not -1
+    int here() { return function->code.size(); }
+    int emit(tree_node *t, int op, int a, int b = 0, int c = 0);
+    void patch(int jump, int target) { function->code[jump].c = target; }
+
+    int int_const(Symbol sym);          // pool indexes
+    int float_const(Symbol sym);
+    int string_const(Symbol sym);
+
+    // the register of variable b, or -1 for a global
+    int reg(const Binding &b);
+
+    // the registers a and b, with an Int one converted if the other is
+    // a Float; false if they are not both numbers
+    bool numbers(tree_node *t, Expr e1, int &a, Expr e2, int &b);
+
+    void enter_loop() { loops.push_back(Loop()); }
+    void exit_loop(int end, int next);  // patch its breaks and continues
+    bool in_loop() { return !loops.empty(); }
+    void add_break(int jump) { loops.back().breaks.push_back(jump); }
+    void add_continue(int jump) { loops.back().continues.push_back(jump); }
+
+    ostream &error(tree_node *t);       // what the checker let through
+};
+
+extern int run_program;      // -x: run the program instead of dumping it
+extern int cgen_debug;       // -c: and list its bytecode
+
+// the bytecode of a checked program, or NULL if it cannot be run
+Bytecode *compile_bytecode(Program program);
+
+// run main; returns the exit status
+int run_bytecode(Bytecode &program);
+
+#endif
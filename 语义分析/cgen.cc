@@ -0,0 +1,907 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: cgen.cc
+//
+// x86-64 assembly from bytecode, one bytecode instruction at a time.
+// A result whose register is in a machine register is computed there;
+// otherwise operands are loaded into %rax and %rcx (%xmm0 and %xmm1 for
+// Floats), worked on there, and the result stored back.  Division also
+// uses %rdx.  None of these three is ever allocated (see regalloc.cc).
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "cgen.h"
+
+extern int cgen_debug;
+
+static const char *arg_regs[] = { "%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9" };
+
+// a string constant for .string: quotes, backslashes and anything not
+// printable escaped in octal
+static std::string quote(const char *s)
+{
+    std::string q = "\"";
+    for (; *s != '\0'; s++) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\') {
+            q += '\\';
+            q += c;
+        } else if (c < ' ' || c >= 127) {
+            char octal[8];
+            snprintf(octal, sizeof octal, "\\%03o", c);
+            q += octal;
+        } else {
+            q += c;
+        }
+    }
+    return q + "\"";
+}
+
+// whether an instruction sets its register a
+static bool writes(int op)
+{
+    switch (op) {
+    case OP_SETG:
+    case OP_PRINTF:
+    case OP_RET:
+    case OP_RETV:
+        return false;
+    default:
+        return op < OP_JMP || op > OP_JNEI;
+    }
+}
+
+static std::string imm(long long n)
+{
+    std::ostringstream s;
+    s << '$' << n;
+    return s.str();
+}
+
+//
+// The code of one function.
+//
+class CgenFunction {
+private:
+    Bytecode &program;
+    int index;
+    BytecodeFunction &fn;
+    ostream &s;
+    std::vector<std::string> &formats;  // printf formats, rewritten
+    Allocation allocation;
+    std::vector<std::string> where;     // each register's, from allocation
+    std::vector<bool> target;           // instructions jumped to
+    std::vector<int> faults;            // divisions that check for zero
+    std::vector<std::string> &returns;  // each call's return address and
+                                        // line, for seal_stack_overflow
+    int rax;                            // register %rax holds, or -1
+    std::vector<bool> known;            // -O: registers last set by LOADI
+    std::vector<int> value;             // to these
+
+    std::string label(int i)
+    {
+        std::ostringstream l;
+        l << ".L" << index << "_" << i;
+        return l.str();
+    }
+
+    void op(const std::string &text) { s << "\t" << text << "\n"; }
+
+    bool in_register(int v) { return where[v][0] == '%'; }
+
+    // register v as a source operand: an immediate if its value is known
+    std::string operand(int v)
+    {
+        return known[v] ? imm(value[v]) : where[v];
+    }
+
+    // %rax = register v, unless it is there already
+    void load(int v)
+    {
+        if (cgen_optimize && rax == v)
+            return;
+        op("movq " + operand(v) + ", %rax");
+        rax = v;
+    }
+
+    // register v = %rax, which then holds it
+    void store(int v)
+    {
+        op("movq %rax, " + where[v]);
+        rax = v;
+    }
+
+    // register v changes other than through %rax
+    void clobber(int v)
+    {
+        if (rax == v)
+            rax = -1;
+    }
+
+    // where to compute register v: in its machine register if it has one
+    std::string into(int v) { return in_register(v) ? where[v] : "%rax"; }
+
+    // register v has been computed into(v)
+    void computed(int v)
+    {
+        if (in_register(v))
+            clobber(v);
+        else
+            store(v);
+    }
+
+    void int_op(const char *name, const Insn &in, bool commutes);
+    void unary(const std::string &name, const Insn &in);
+    void float_op(const char *name, const Insn &in);
+    void compare(const char *set, const Insn &in);
+    void float_compare(const Insn &in);
+    void string_compare(const char *set, const Insn &in);
+    void divide(const Insn &in, int i);
+    void jump(const char *cond, const Insn &in);
+    void call(const Insn &in, int i);
+    const char *constant_string(int r);
+    void pass_arg(char how, int v, const char *r, const char *x);
+    void print(const Insn &in);
+    void epilogue();
+    void insn(int i);
+public:
+    CgenFunction(Bytecode &p, int i, ostream &out, std::vector<std::string> &f,
+                 std::vector<std::string> &r)
+        : program(p), index(i), fn(p.functions[i]), s(out), formats(f), returns(r) { }
+    void code();
+};
+
+//
+// In a machine register a is worked on where it is, unless it is c as
+// well as the first operand, which would be lost when b is copied in.
+//
+void CgenFunction::int_op(const char *name, const Insn &in, bool commutes)
+{
+    int b = in.b, c = in.c;
+    if (commutes && where[in.a] == where[c] && where[in.a] != where[b])
+        std::swap(b, c);
+    if (in_register(in.a) && (where[in.a] != where[c] || where[in.a] == where[b])) {
+        if (where[in.a] != where[b])
+            op("movq " + operand(b) + ", " + where[in.a]);
+        op(std::string(name) + " " + operand(c) + ", " + where[in.a]);
+        clobber(in.a);
+    } else {
+        load(b);
+        op(std::string(name) + " " + operand(c) + ", %rax");
+        store(in.a);
+    }
+}
+
+// name is the instruction with any operand before a's
+void CgenFunction::unary(const std::string &name, const Insn &in)
+{
+    if (!in_register(in.a))
+        load(in.b);
+    else if (where[in.a] != where[in.b])
+        op("movq " + operand(in.b) + ", " + where[in.a]);
+    op(name + into(in.a));
+    computed(in.a);
+}
+
+void CgenFunction::float_op(const char *name, const Insn &in)
+{
+    op("movq " + where[in.b] + ", %xmm0");
+    op("movq " + where[in.c] + ", %xmm1");
+    op(std::string(name) + " %xmm1, %xmm0");
+    op("movq %xmm0, " + where[in.a]);
+    clobber(in.a);
+}
+
+void CgenFunction::compare(const char *set, const Insn &in)
+{
+    if (in_register(in.b)) {
+        op("cmpq " + operand(in.c) + ", " + where[in.b]);
+    } else {
+        load(in.b);
+        op("cmpq " + operand(in.c) + ", %rax");
+    }
+    op(std::string(set) + " %al");
+    op("movzbl %al, %eax");
+    store(in.a);
+}
+
+//
+// ucomisd leaves the flags as an unsigned comparison would, and sets
+// the parity flag when either operand is NaN, for which every
+// comparison but != is false.
+//
+void CgenFunction::float_compare(const Insn &in)
+{
+    op("movq " + where[in.b] + ", %xmm0");
+    op("movq " + where[in.c] + ", %xmm1");
+    switch (in.op) {
+    case OP_LTF:                        // c above b
+        op("ucomisd %xmm0, %xmm1");
+        op("seta %al");
+        break;
+    case OP_LEF:
+        op("ucomisd %xmm0, %xmm1");
+        op("setae %al");
+        break;
+    case OP_EQF:
+        op("ucomisd %xmm1, %xmm0");
+        op("sete %al");
+        op("setnp %cl");
+        op("andb %cl, %al");
+        break;
+    default:
+        op("ucomisd %xmm1, %xmm0");
+        op("setne %al");
+        op("setp %cl");
+        op("orb %cl, %al");
+        break;
+    }
+    op("movzbl %al, %eax");
+    store(in.a);
+}
+
+void CgenFunction::string_compare(const char *set, const Insn &in)
+{
+    op("movq " + where[in.b] + ", %rdi");
+    op("movq " + where[in.c] + ", %rsi");
+    op("call strcmp@PLT");
+    op("testl %eax, %eax");
+    op(std::string(set) + " %al");
+    op("movzbl %al, %eax");
+    store(in.a);
+}
+
+//
+// idiv traps on a zero divisor and on the smallest Int divided by -1;
+// the first stops the program as the virtual machine does, and the
+// second wraps around.  A divisor known to be neither needs no tests.
+//
+void CgenFunction::divide(const Insn &in, int i)
+{
+    if (known[in.c] && value[in.c] != 0 && value[in.c] != -1) {
+        load(in.b);
+        op("movq " + imm(value[in.c]) + ", %rcx");
+        op("cqto");
+        op("idivq %rcx");
+        if (in.op == OP_MOD)
+            op("movq %rdx, %rax");
+        store(in.a);
+        return;
+    }
+    std::string minus = label(i) + "_m1", done = label(i) + "_done";
+    op("movq " + where[in.c] + ", %rcx");
+    op("testq %rcx, %rcx");
+    op("je " + label(i) + "_zero");
+    faults.push_back(i);
+    op("cmpq $-1, %rcx");
+    op("je " + minus);
+    load(in.b);
+    op("cqto");
+    op("idivq %rcx");
+    if (in.op == OP_MOD)
+        op("movq %rdx, %rax");
+    op("movq %rax, " + where[in.a]);
+    op("jmp " + done);
+    s << minus << ":\n";
+    if (in.op == OP_DIV) {
+        op("movq " + where[in.b] + ", %rax");
+        op("negq %rax");
+    } else {
+        op("xorl %eax, %eax");
+    }
+    op("movq %rax, " + where[in.a]);
+    s << done << ":\n";
+    rax = -1;
+}
+
+void CgenFunction::jump(const char *cond, const Insn &in)
+{
+    if (in_register(in.a) || in_register(in.b) || known[in.b]) {
+        op("cmpq " + operand(in.b) + ", " + where[in.a]);
+    } else {
+        load(in.a);
+        op("cmpq " + operand(in.b) + ", %rax");
+    }
+    op(std::string(cond) + " " + label(in.c));
+}
+
+void CgenFunction::call(const Insn &in, int i)
+{
+    BytecodeFunction &callee = program.functions[in.b];
+    for (int p = 0; p < callee.params; p++)
+        op("movq " + where[in.c + p] + ", " + arg_regs[p]);
+    op(std::string("call seal_") + callee.name->get_string());
+    s << label(i) << "_ret:\n";
+    std::ostringstream entry;
+    entry << "\t.long " << label(i) << "_ret - .\n\t.long " << fn.lines[i] << "\n";
+    returns.push_back(entry.str());
+    store(in.a);
+}
+
+//
+// printf in the virtual machine converts each argument to what its
+// conversion wants (see vm.cc).  With the format a string constant, the
+// same is done here as the program is compiled: the format is rewritten
+// the way the virtual machine rewrites each conversion, and each
+// argument gets a letter for what to pass.  i and f are an integer and
+// a Float as they are, I and F a Float made an Int and an Int made a
+// Float, and n the string "(null)"; an argument no conversion takes is
+// left out.  A format in a variable is passed as it is, and so are the
+// arguments, by their types.
+//
+static std::string escape(const char *text, size_t n)
+{
+    std::string e;
+    for (size_t i = 0; i < n; i++) {
+        if (text[i] == '%')
+            e += '%';
+        e += text[i];
+    }
+    return e;
+}
+
+static std::string reformat(const char *f, const char *types, int n, std::string &pass)
+{
+    std::string out;
+    int next = 1;
+    while (*f != '\0') {
+        const char *percent = strchr(f, '%');
+        if (percent == NULL) {
+            out += escape(f, strlen(f));
+            break;
+        }
+        out += escape(f, percent - f);
+        f = percent + 1;
+        f += strspn(f, "-+ #0");
+        f += strspn(f, "0123456789");
+        if (*f == '.') {
+            f++;
+            f += strspn(f, "0123456789");
+        }
+        f += strspn(f, "hljzqtL");
+        char conv = *f;
+        if (conv == '\0') {
+            out += escape(percent, strlen(percent));
+            break;
+        }
+        f++;
+        if (conv == '%') {
+            out += "%%";
+            continue;
+        }
+        std::string spec(percent, f - percent);
+        char type = next < n ? types[next] : 0;
+        if (type == 0) {
+            out += escape(spec.data(), spec.size());
+        } else if (strchr("diouxXc", conv)) {
+            if (conv != 'c' && spec.find_first_of("ljzqtL") != std::string::npos)
+                spec = spec.substr(0, spec.find_first_of("hljzqtL")) + "ll" + conv;
+            out += spec;
+            pass += type == 'f' ? 'I' : 'i';
+            next++;
+        } else if (strchr("fFeEgGaA", conv)) {
+            std::string::size_type at = spec.find_first_of("hljzqtL");
+            if (at != std::string::npos)
+                spec = spec.substr(0, at) + conv;
+            out += spec;
+            pass += type == 'f' ? 'f' : 'F';
+            next++;
+        } else if (conv == 's') {
+            out += spec;
+            pass += type == 's' ? 'i' : 'n';
+            next++;
+        } else if (conv == 'p') {
+            out += spec;
+            pass += 'i';
+            next++;
+        } else {
+            out += escape(spec.data(), spec.size());
+        }
+    }
+    return out;
+}
+
+// the string constant register r holds, if it is only ever loaded with one
+const char *CgenFunction::constant_string(int r)
+{
+    const char *string = NULL;
+    for (size_t i = 0; i < fn.code.size(); i++) {
+        const Insn &in = fn.code[i];
+        if (!writes(in.op) || in.a != r)
+            continue;
+        if (in.op != OP_LOADS || string != NULL)
+            return NULL;
+        string = program.strings[in.b];
+    }
+    return string;
+}
+
+//
+// printf is variadic: the first six integers and pointers go in the
+// integer argument registers, the first eight Floats in %xmm0-%xmm7 with
+// their number in %al, and the rest on the stack in order.
+//
+void CgenFunction::print(const Insn &in)
+{
+    const char *types = program.strings[in.c];
+    const char *format = constant_string(in.a);
+    std::vector<int> args;              // registers passed after the format
+    std::string pass;                   // and how, as above
+    if (format != NULL) {
+        std::ostringstream label;
+        label << ".LP" << formats.size();
+        formats.push_back(reformat(format, types, in.b, pass));
+        op("leaq " + label.str() + "(%rip), %rdi");
+        for (int i = 1; i < in.b && args.size() < pass.size(); i++)
+            args.push_back(in.a + i);
+    } else {
+        op("movq " + where[in.a] + ", %rdi");
+        for (int i = 1; i < in.b; i++) {
+            args.push_back(in.a + i);
+            pass += types[i] == 'f' ? 'f' : 'i';
+        }
+    }
+
+    std::vector<int> stack;             // indexes into args
+    int ints = 1, floats = 0;
+    for (size_t i = 0; i < args.size(); i++) {
+        bool f = pass[i] == 'f' || pass[i] == 'F';
+        if (f ? floats++ >= 8 : ints++ >= 6)
+            stack.push_back(i);
+    }
+    if (stack.size() % 2 != 0)
+        op("subq $8, %rsp");
+    for (int i = stack.size() - 1; i >= 0; i--) {
+        pass_arg(pass[stack[i]], args[stack[i]], "%rax", "%xmm0");
+        if (pass[stack[i]] == 'f' || pass[stack[i]] == 'F')
+            op("movq %xmm0, %rax");
+        op("pushq %rax");
+    }
+    ints = 1;
+    floats = 0;
+    for (size_t i = 0; i < args.size(); i++) {
+        std::ostringstream x;
+        x << "%xmm" << floats;
+        if (pass[i] == 'f' || pass[i] == 'F') {
+            if (floats++ < 8)
+                pass_arg(pass[i], args[i], NULL, x.str().c_str());
+        } else {
+            if (ints < 6)
+                pass_arg(pass[i], args[i], arg_regs[ints], NULL);
+            ints++;
+        }
+    }
+    op("movl " + imm(floats < 8 ? floats : 8) + ", %eax");
+    op("call printf@PLT");
+    int pushed = (stack.size() + 1) / 2 * 16;
+    if (pushed > 0)
+        op("addq " + imm(pushed) + ", %rsp");
+    rax = -1;
+}
+
+// one argument of printf into the integer register r or the xmm register x
+void CgenFunction::pass_arg(char how, int v, const char *r, const char *x)
+{
+    switch (how) {
+    case 'i':
+        op("movq " + where[v] + ", " + r);
+        break;
+    case 'f':
+        op("movq " + where[v] + ", " + x);
+        break;
+    case 'I':
+        op("movq " + where[v] + ", %xmm15");    // not an argument register
+        op(std::string("cvttsd2siq %xmm15, ") + r);
+        break;
+    case 'F':
+        op("cvtsi2sdq " + where[v] + ", " + x);
+        break;
+    case 'n':
+        op(std::string("leaq .Lnull(%rip), ") + r);
+        break;
+    }
+}
+
+void CgenFunction::epilogue()
+{
+    for (size_t r = 0; r < allocation.saved.size(); r++) {
+        std::ostringstream slot;
+        slot << -8 * (int) (r + 1) << "(%rbp)";
+        op("movq " + slot.str() + ", " + allocation.saved[r]);
+    }
+    op("leave");
+    op("ret");
+}
+
+void CgenFunction::insn(int i)
+{
+    const Insn &in = fn.code[i];
+    if (target[i]) {
+        s << label(i) << ":\n";
+        rax = -1;
+        known.assign(fn.regs, false);
+    }
+    if (cgen_debug) {
+        char text[80];
+        snprintf(text, sizeof text, "\t# %-6s %d %d %d, line %d\n",
+                 opcode_names[in.op], in.a, in.b, in.c, fn.lines[i]);
+        s << text;
+    }
+    if (allocation.dead[i])
+        return;
+    switch (in.op) {
+    case OP_MOV:
+        if (in_register(in.a) || in_register(in.b) || known[in.b]) {
+            if (where[in.a] != where[in.b])
+                op("movq " + operand(in.b) + ", " + where[in.a]);
+            clobber(in.a);
+        } else {
+            load(in.b);
+            store(in.a);
+        }
+        break;
+    case OP_LOADI:
+        op("movq " + imm(in.b) + ", " + where[in.a]);
+        clobber(in.a);
+        break;
+    case OP_LOADK:
+        op("movabsq " + imm(program.ints[in.b]) + ", " + into(in.a));
+        computed(in.a);
+        break;
+    case OP_LOADF: {
+        std::ostringstream k;
+        k << ".LF" << in.b << "(%rip)";
+        op("movq " + k.str() + ", " + into(in.a));
+        computed(in.a);
+        break;
+    }
+    case OP_LOADS: {
+        std::ostringstream k;
+        k << ".LS" << in.b << "(%rip)";
+        op("leaq " + k.str() + ", " + into(in.a));
+        computed(in.a);
+        break;
+    }
+    case OP_GETG: {
+        std::ostringstream g;
+        g << "seal_globals+" << 8 * in.b << "(%rip)";
+        op("movq " + g.str() + ", " + into(in.a));
+        computed(in.a);
+        break;
+    }
+    case OP_SETG: {
+        std::ostringstream g;
+        g << "seal_globals+" << 8 * in.a << "(%rip)";
+        if (in_register(in.b) || known[in.b]) {
+            op("movq " + operand(in.b) + ", " + g.str());
+        } else {
+            load(in.b);
+            op("movq %rax, " + g.str());
+        }
+        break;
+    }
+    case OP_ADD:  int_op("addq", in, true); break;
+    case OP_SUB:  int_op("subq", in, false); break;
+    case OP_MUL:  int_op("imulq", in, true); break;
+    case OP_BAND: int_op("andq", in, true); break;
+    case OP_BOR:  int_op("orq", in, true); break;
+    case OP_XOR:  int_op("xorq", in, true); break;
+    case OP_DIV:
+    case OP_MOD:
+        divide(in, i);
+        break;
+    case OP_ADDI:
+        if (in_register(in.a) && in_register(in.b) && where[in.a] != where[in.b]) {
+            std::ostringstream sum;
+            sum << "leaq " << in.c << "(" << where[in.b] << "), " << where[in.a];
+            op(sum.str());
+            clobber(in.a);
+        } else {
+            unary("addq " + imm(in.c) + ", ", in);
+        }
+        break;
+    case OP_ADDF: float_op("addsd", in); break;
+    case OP_SUBF: float_op("subsd", in); break;
+    case OP_MULF: float_op("mulsd", in); break;
+    case OP_DIVF: float_op("divsd", in); break;
+    case OP_NEG:  unary("negq ", in); break;
+    case OP_NEGF: unary("btcq $63, ", in); break;
+    case OP_I2F:
+        op("cvtsi2sdq " + where[in.b] + ", %xmm0");
+        op("movq %xmm0, " + where[in.a]);
+        clobber(in.a);
+        break;
+    case OP_BNOT: unary("notq ", in); break;
+    case OP_NOT:  unary("xorq $1, ", in); break;
+    case OP_LT: compare("setl", in); break;
+    case OP_LE: compare("setle", in); break;
+    case OP_EQ: compare("sete", in); break;
+    case OP_NE: compare("setne", in); break;
+    case OP_LTF:
+    case OP_LEF:
+    case OP_EQF:
+    case OP_NEF:
+        float_compare(in);
+        break;
+    case OP_LTS: string_compare("setl", in); break;
+    case OP_LES: string_compare("setle", in); break;
+    case OP_EQS: string_compare("sete", in); break;
+    case OP_NES: string_compare("setne", in); break;
+    case OP_JMP:
+        op("jmp " + label(in.c));
+        break;
+    case OP_JT:
+    case OP_JF:
+        if (known[in.a]) {              // always or never taken
+            if ((value[in.a] != 0) == (in.op == OP_JT))
+                op("jmp " + label(in.c));
+            break;
+        }
+        if (in_register(in.a))
+            op("testq " + where[in.a] + ", " + where[in.a]);
+        else
+            op("cmpq $0, " + where[in.a]);
+        op(std::string(in.op == OP_JT ? "jne " : "je ") + label(in.c));
+        break;
+    case OP_JLT: jump("jl", in); break;
+    case OP_JLE: jump("jle", in); break;
+    case OP_JEQ: jump("je", in); break;
+    case OP_JNE: jump("jne", in); break;
+    case OP_JLTI:
+    case OP_JLEI:
+    case OP_JGTI:
+    case OP_JGEI:
+    case OP_JEQI:
+    case OP_JNEI: {
+        static const char *cond[] = { "jl ", "jle ", "jg ", "jge ", "je ", "jne " };
+        if (known[in.a]) {
+            long long a = value[in.a], b = in.b;
+            bool taken[] = { a < b, a <= b, a > b, a >= b, a == b, a != b };
+            if (taken[in.op - OP_JLTI])
+                op("jmp " + label(in.c));
+            break;
+        }
+        op("cmpq " + imm(in.b) + ", " + where[in.a]);
+        op(cond[in.op - OP_JLTI] + label(in.c));
+        break;
+    }
+    case OP_CALL:
+        call(in, i);
+        break;
+    case OP_PRINTF:
+        print(in);
+        break;
+    case OP_RET:
+        load(in.a);
+        epilogue();
+        break;
+    case OP_RETV:
+        epilogue();
+        break;
+    }
+    if (cgen_optimize && writes(in.op)) {
+        known[in.a] = in.op == OP_LOADI;
+        value[in.a] = in.b;
+    }
+}
+
+//
+// The frame: the saved %rbp, the callee-saved registers the function
+// uses, then the stack slots, rounded up to keep the stack 16-byte
+// aligned.
+//
+// Once the frame is allocated, %rsp is checked against the limit main
+// set, and below it the function goes to seal_stack_overflow with its
+// return address.  A function that calls none and has a small frame
+// cannot get far past the limit, which leaves room for it, and is not
+// checked.
+//
+void CgenFunction::code()
+{
+    const char *name = fn.name->get_string();
+    allocate_registers(program, index, allocation);
+    where.swap(allocation.where);
+
+    target.assign(fn.code.size(), false);
+    bool calls = false;
+    for (size_t i = 0; i < fn.code.size(); i++) {
+        int o = fn.code[i].op;
+        if (o == OP_JMP || o == OP_JT || o == OP_JF || (o >= OP_JLT && o <= OP_JNEI))
+            target[fn.code[i].c] = true;
+        calls = calls || o == OP_CALL;
+    }
+    bool guard = calls || allocation.frame > 4096;
+    std::string overflow = label(0) + "_overflow";
+
+    s << "\n\t.globl seal_" << name << "\n"
+      << "\t.type seal_" << name << ", @function\n"
+      << "seal_" << name << ":\n";
+    if (cgen_debug) {
+        s << "\t# " << allocation.in_registers << " registers in machine registers, "
+          << allocation.spilled << " spilled\n";
+    }
+    op("pushq %rbp");
+    op("movq %rsp, %rbp");
+    if (allocation.frame > 0)
+        op("subq " + imm(allocation.frame) + ", %rsp");
+    if (guard) {
+        op("cmpq seal_stack_limit(%rip), %rsp");
+        op("jb " + overflow);
+    }
+    for (size_t r = 0; r < allocation.saved.size(); r++) {
+        std::ostringstream slot;
+        slot << -8 * (int) (r + 1) << "(%rbp)";
+        op(std::string("movq ") + allocation.saved[r] + ", " + slot.str());
+    }
+    for (int p = 0; p < fn.params; p++) {
+        if (where[p] != "")
+            op(std::string("movq ") + arg_regs[p] + ", " + where[p]);
+    }
+    rax = -1;
+    known.assign(fn.regs, false);
+    value.assign(fn.regs, 0);
+    for (size_t i = 0; i < fn.code.size(); i++)
+        insn(i);
+
+    for (size_t f = 0; f < faults.size(); f++) {
+        s << label(faults[f]) << "_zero:\n";
+        op("movl " + imm(fn.lines[faults[f]]) + ", %edi");
+        op("call seal_divide_by_zero");
+    }
+    if (guard) {
+        s << overflow << ":\n";
+        op("movq 8(%rbp), %rdi");
+        op("movl " + imm(fn.lines.empty() ? 0 : fn.lines[0]) + ", %esi");
+        op("call seal_stack_overflow");
+    }
+    s << "\t.size seal_" << name << ", .-seal_" << name << "\n";
+}
+
+void cgen(Bytecode &program, ostream &s)
+{
+    s << "# SEAL program, x86-64 System V\n"
+      << "\t.section .rodata\n";
+    for (size_t i = 0; i < program.strings.size(); i++)
+        s << ".LS" << i << ":\n\t.string " << quote(program.strings[i]) << "\n";
+    s << "\t.align 8\n";
+    for (size_t i = 0; i < program.floats.size(); i++) {
+        long long bits;
+        memcpy(&bits, &program.floats[i], sizeof bits);
+        s << ".LF" << i << ":\n\t.quad " << bits << "\n";
+    }
+    s << ".Ldivide_by_zero:\n\t.string \"%d: Division by zero.\\n\"\n"
+      << ".Lstack_overflow:\n\t.string \"%d: Stack overflow.\\n\"\n";
+    s << "\t.bss\n\t.align 8\nseal_stack_limit:\n\t.zero 8\n";
+    if (program.globals > 0)
+        s << "seal_globals:\n\t.zero " << 8 * program.globals << "\n";
+
+    s << "\t.text\n";
+    std::vector<std::string> formats, returns;
+    for (size_t f = 0; f < program.functions.size(); f++)
+        CgenFunction(program, f, s, formats, returns).code();
+    s << "\n\t.section .rodata\n";
+    for (size_t i = 0; i < formats.size(); i++)
+        s << ".LP" << i << ":\n\t.string " << quote(formats[i].c_str()) << "\n";
+    s << ".Lnull:\n\t.string \"(null)\"\n"
+      << "\t.align 4\n"
+      << ".Lreturns:\n";
+    for (size_t i = 0; i < returns.size(); i++)
+        s << returns[i];
+    s << ".Lreturns_end:\n"
+      << "\t.text\n";
+
+    // the C main, which leaves seal_main three quarters of the stack the
+    // limit allows, up to 1G: the rest is for printf and for a leaf's
+    // frame past the limit
+    s << "\n\t.globl main\n"
+      << "\t.type main, @function\n"
+      << "main:\n"
+      << "\tpushq %rbp\n"
+      << "\tmovq %rsp, %rbp\n"
+      << "\tsubq $16, %rsp\n"
+      << "\tmovq $8388608, (%rsp)\n"
+      << "\tmovl $3, %edi\n"                    // RLIMIT_STACK
+      << "\tmovq %rsp, %rsi\n"
+      << "\tcall getrlimit@PLT\n"
+      << "\tmovq (%rsp), %rax\n"
+      << "\tmovl $1073741824, %ecx\n"
+      << "\tcmpq %rcx, %rax\n"
+      << "\tcmova %rcx, %rax\n"
+      << "\tmovq %rax, %rcx\n"
+      << "\tshrq $2, %rcx\n"
+      << "\tsubq %rcx, %rax\n"
+      << "\tmovq %rbp, %rcx\n"
+      << "\tsubq %rax, %rcx\n"
+      << "\tmovq %rcx, seal_stack_limit(%rip)\n"
+      << "\tcall seal_main\n"
+      << "\txorl %eax, %eax\n"
+      << "\tleave\n"
+      << "\tret\n"
+      << "\n"
+      // a function past the limit comes here with its return address in
+      // %rdi and its own line in %esi; the line the VM gives is that of
+      // the call, looked up by the address
+      << "seal_stack_overflow:\n"
+      << "\tleaq .Lreturns(%rip), %rax\n"
+      << "\tleaq .Lreturns_end(%rip), %rdx\n"
+      << "1:\n"
+      << "\tcmpq %rdx, %rax\n"
+      << "\tjae 3f\n"
+      << "\tmovslq (%rax), %rcx\n"
+      << "\taddq %rax, %rcx\n"
+      << "\tcmpq %rdi, %rcx\n"
+      << "\tje 2f\n"
+      << "\taddq $8, %rax\n"
+      << "\tjmp 1b\n"
+      << "2:\n"
+      << "\tmovl 4(%rax), %esi\n"
+      << "3:\n"
+      << "\tmovl %esi, %edi\n"
+      << "\tleaq .Lstack_overflow(%rip), %rsi\n"
+      << "\tjmp seal_fault\n"
+      << "\n"
+      // a division by zero, with its line in %edi
+      << "seal_divide_by_zero:\n"
+      << "\tleaq .Ldivide_by_zero(%rip), %rsi\n"
+      // write the message %rsi for the line %edi, as the VM does, and exit
+      << "seal_fault:\n"
+      << "\tpushq %rbx\n"
+      << "\tpushq %r12\n"
+      << "\tsubq $8, %rsp\n"
+      << "\tmovl %edi, %ebx\n"
+      << "\tmovq %rsi, %r12\n"
+      << "\txorl %edi, %edi\n"
+      << "\tcall fflush@PLT\n"
+      << "\tmovq stderr@GOTPCREL(%rip), %rax\n"
+      << "\tmovq (%rax), %rdi\n"
+      << "\tmovq %r12, %rsi\n"
+      << "\tmovl %ebx, %edx\n"
+      << "\txorl %eax, %eax\n"
+      << "\tcall fprintf@PLT\n"
+      << "\tmovl $1, %edi\n"
+      << "\tcall exit@PLT\n"
+      << "\t.section .note.GNU-stack,\"\",@progbits\n";
+}
+
+int cgen_output(Bytecode &program)
+{
+    std::string out = out_filename;
+    bool assembly = out.size() > 2 && out.compare(out.size() - 2, 2, ".s") == 0;
+    std::string file = assembly ? out : out + ".s";
+    {
+        std::ofstream s(file.c_str());
+        if (!s) {
+            cerr << "Could not write " << file << endl;
+            return 1;
+        }
+        cgen(program, s);
+        if (!s) {
+            cerr << "Could not write " << file << endl;
+            return 1;
+        }
+    }
+    if (assembly)
+        return 0;
+    std::string command = "cc -o '" + out + "' '" + file + "'";
+    int status = system(command.c_str());
+    if (!cgen_debug)        // -c keeps the assembly
+        unlink(file.c_str());
+    if (status != 0) {
+        cerr << "Could not assemble and link " << out << endl;
+        return 1;
+    }
+    return 0;
+}
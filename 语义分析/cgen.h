@@ -0,0 +1,80 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _CGEN_H_
+#define _CGEN_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: cgen.h
+//
+// The native code generator: x86-64 assembly for the GNU assembler,
+// lowered from a program's bytecode (see bytecode.h).
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include "bytecode.h"
+
+//
+// The code follows the System V calling convention where it meets C:
+// main is a C main, printf is called as a variadic C function, and the
+// stack is 16-byte aligned at every call.  SEAL functions call each
+// other a simpler way.  All of a function's parameters, at most six,
+// come in the six integer argument registers %rdi, %rsi, %rdx, %rcx, %r8
+// and %r9, Floats by their bits.  The result comes back in %rax, a Float
+// also by its bits.  Each function is the symbol seal_<name>, so SEAL
+// names cannot clash with the C library's.
+//
+// Each register of the bytecode function lives in a machine register
+// or a stack slot of its frame, as regalloc.cc decides.  With -O, a
+// value still in %rax is not loaded again, and a register set from a
+// constant is used as an immediate until the next label: divisions by
+// it need no tests, and branches on it are decided.
+//
+// Faults end the program as they end the VM's: a division by zero, and
+// a stack overflow, which each function that calls another checks for
+// on entry against a limit main takes from RLIMIT_STACK.  Both write
+// their message with the line the VM would give, the line of the call
+// for an overflow, and exit with status 1.
+//
+extern int cgen_optimize;       // -O
+extern char *out_filename;      // -o
+extern bool disable_reg_alloc;  // -r
+
+//
+// Where the registers of one bytecode function live: each in one of the
+// machine registers the allocator hands out, or in a stack slot below
+// the callee-saved registers it uses, which are saved at the top of the
+// frame.  A register the function never touches is nowhere ("").
+//
+struct Allocation {
+    std::vector<std::string> where;     // "%rbx", "-24(%rbp)", ...
+    std::vector<const char *> saved;    // callee-saved registers used
+    std::vector<bool> dead;             // instructions left out: their
+                                        // results are never used
+    int frame;                          // bytes below %rbp, a multiple of 16
+    int in_registers;                   // registers given a machine register
+    int spilled;                        // and given a stack slot instead
+};
+
+//
+// Linear-scan allocation over the live intervals of function f's
+// registers, or with -r every register in a stack slot.
+//
+void allocate_registers(Bytecode &program, int f, Allocation &allocation);
+
+// write the assembly for program to s
+void cgen(Bytecode &program, ostream &s);
+
+//
+// -o: write the assembly to out_filename if it ends in .s, else build
+// the executable out_filename with the system's C compiler driver.
+// Returns the exit status.
+//
+int cgen_output(Bytecode &program);
+
+#endif
@@ -0,0 +1,204 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: compilation.cc
+//
+// The state of one compilation.  See compilation.h.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <string>
+#include "compilation.h"
+
+CompilationContext::CompilationContext(FILE *in_, char *filename_, AstArena *nodes)
+    : map_length(0), token_file(NULL), pushed_read(0), pushed_end(false),
+      push_status(YYPUSH_MORE), in(in_), filename(filename_), lineno(1), errors(0),
+      token(0), map(NULL), map_size(0), tokens(NULL), root(NULL),
+      on_decl(NULL), on_decl_data(NULL), pushing(false), starved(false),
+      cutting(false), pstate(NULL)
+{
+    outer_arena = ast_arena;
+    ast_arena = nodes != NULL ? nodes : &arena;
+}
+
+CompilationContext::~CompilationContext()
+{
+    if (map != NULL && map_length != 0)
+        munmap(map, map_length);
+    delete tokens;
+    if (token_file != NULL)
+        fclose(token_file);
+    if (pstate != NULL)
+        seal_yypush_free(this);
+    ast_arena = outer_arena;
+}
+
+//
+// flex scans a buffer in place only if it ends in two NULs.  The file is
+// mapped over a zeroed anonymous region one page longer than needed, so
+// the bytes after the end of the file read as NULs even when the file
+// ends on a page boundary.  The mapping is private and writable because
+// the scanner NUL-terminates each token in its buffer; only the pages it
+// writes to are copied.
+//
+bool CompilationContext::map_input()
+{
+    struct stat st;
+    int fd = fileno(in);
+
+    if (map != NULL)
+        return true;
+    if (fd < 0 || fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    size_t length = st.st_size;
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t mapped = (length + 2 + page - 1) / page * page;
+    void *base = mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return false;
+    if (length > 0 &&
+        mmap(base, length, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, mapped);
+        return false;
+    }
+    madvise(base, length, MADV_SEQUENTIAL);
+
+    map = (char *) base;
+    map_size = length + 2;
+    map_length = mapped;
+    return true;
+}
+
+void CompilationContext::scan_buffer(char *buf, size_t size)
+{
+    map = buf;
+    map_size = size;
+    map_length = 0;
+}
+
+bool CompilationContext::read_tokens()
+{
+    if (tokens == NULL && is_token_stream(in))
+        tokens = new TokenReader(in, filename);
+    return tokens != NULL;
+}
+
+bool CompilationContext::save_tokens()
+{
+    std::string name = std::string(filename) + "tok";
+    FILE *out = fopen(name.c_str(), "w+");
+    if (out == NULL)
+        return false;
+
+    TokenWriter writer(out);
+    YYSTYPE value;
+    int tok;
+
+    while ((tok = seal_yyscan(&value, this)) != 0)
+        writer.write(tok, value, lineno);
+    writer.finish(lineno);
+    seal_yyscan_reset();
+
+    rewind(out);
+    is_token_stream(out);
+    token_file = out;
+    tokens = new TokenReader(out, filename);
+    lineno = 1;
+    return true;
+}
+
+Program CompilationContext::parse()
+{
+    seal_yyparse(this);
+    seal_yyscan_reset();
+    if (errors != 0)
+        return NULL;
+    return root;
+}
+
+//
+// The scanner reads pushed bytes through read_pushed().  When it has read
+// them all and wants more, it is starved: the token it returns then may
+// go on in the next chunk, so scan_pushed() drops it, and everything
+// scanned after the last token it passed on, and scans them again with
+// the next chunk.  Every token before that was matched without the
+// scanner looking beyond the bytes it had, so no later bytes can change
+// it.  The dropped scan may have counted lines and changed the string
+// tables; lineno is put back, and the strings are harmless.
+//
+size_t CompilationContext::read_pushed(char *buf, size_t max)
+{
+    size_t n = pushed.size() - pushed_read;
+    if (n > max)
+        n = max;
+    memcpy(buf, pushed.data() + pushed_read, n);
+    pushed_read += n;
+    if (n == 0 && !pushed_end)
+        starved = true;
+    return n;
+}
+
+void CompilationContext::scan_pushed()
+{
+    size_t passed = 0;          // bytes of pushed scanned into tokens passed on
+    int line = lineno;          // and the line they end on
+
+    pushed_read = 0;
+    starved = false;
+    while (push_status == YYPUSH_MORE) {
+        YYSTYPE value;
+        int tok = seal_yyscan(&value, this);
+        if (starved)
+            break;
+        passed = pushed_read - seal_yyscan_unread();
+        line = lineno;
+        push_status = seal_yypush(this, tok, &value);
+    }
+    seal_yyscan_reset();
+    pushed.erase(0, passed);
+    lineno = line;
+}
+
+bool CompilationContext::push(const char *bytes, size_t n)
+{
+    pushing = true;
+    if (push_status == YYPUSH_MORE) {
+        pushed.append(bytes, n);
+        scan_pushed();
+    }
+    return push_status == YYPUSH_MORE || push_status == 0;
+}
+
+Program CompilationContext::push_end()
+{
+    pushing = true;
+    pushed_end = true;
+    if (push_status == YYPUSH_MORE)
+        scan_pushed();
+    if (push_status != 0 || errors != 0)
+        return NULL;
+    return root;
+}
+
+Program CompilationContext::parse_stream()
+{
+    char buf[65536];
+    ssize_t n;
+
+    while ((n = read(fileno(in), buf, sizeof buf)) > 0)
+        if (!push(buf, n))
+            break;
+    return push_end();
+}
@@ -0,0 +1,142 @@
+//
+// dump_bench.cc
+//
+// Times dump_with_types, the typed AST semant writes, on a wide tree and
+// on a deep one, and reports lines and megabytes written per second.
+//
+//    % make dump_bench
+//    % ./dump_bench [functions [depth]]
+//
+// The wide program is "functions" short functions side by side (default
+// 20000); the deep one is a twentieth as many functions whose bodies
+// nest "depth" loops and an expression "depth" operators deep (default
+// 30), so most of its lines are indented well past 80 columns.  Each program
+// is parsed and checked once, and then dumped three times to /dev/null;
+// the best time is reported.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fstream>
+#include <sstream>
+#include "compilation.h"
+#include "semant.h"
+
+extern int yy_flex_debug;
+
+static double now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void make_wide(FILE *f, int functions)
+{
+   for (int n = 0; n < functions; n++)
+      fprintf(f,
+              "Int func f_%d(Int a, Int b) {\n"
+              "    Int x;\n"
+              "    Int y;\n"
+              "    x = a * %d + b;\n"
+              "    y = 0;\n"
+              "    while x > 0 {\n"
+              "        x = x - 1;\n"
+              "        y = y + x %% 3;\n"
+              "    }\n"
+              "    return y;\n"
+              "}\n\n",
+              n, n % 1000);
+   fprintf(f, "Void func main() {\n    return;\n}\n");
+}
+
+static void make_deep(FILE *f, int functions, int depth)
+{
+   for (int n = 0; n < functions; n++) {
+      fprintf(f, "Int func g_%d(Int a) {\n    Int x;\n    x = a;\n", n);
+      for (int i = 0; i < depth; i++)
+         fprintf(f, "while x > %d {\n", i);
+      fprintf(f, "x = ");
+      for (int i = 0; i < depth; i++)
+         fprintf(f, "a + (");
+      fprintf(f, "x");
+      for (int i = 0; i < depth; i++)
+         fprintf(f, ")");
+      fprintf(f, ";\n");
+      for (int i = 0; i < depth; i++)
+         fprintf(f, "}\n");
+      fprintf(f, "    return x;\n}\n\n");
+   }
+   fprintf(f, "Void func main() {\n    return;\n}\n");
+}
+
+static void take_decl(Decl decl, void *data)
+{
+   Decls *decls = (Decls *) data;
+   *decls = add_Decls(*decls, decl);
+}
+
+static void bench(const char *what, FILE *f)
+{
+   fflush(f);
+   rewind(f);
+   CompilationContext ctx(f, (char *) what);
+   if (!ctx.map_input()) {
+      cerr << what << ": cannot be mapped\n";
+      exit(1);
+   }
+   Decls decls = nil_Decls();
+   ctx.on_decl = take_decl;
+   ctx.on_decl_data = &decls;
+   Program program = ctx.parse();
+   if (program == NULL) {
+      cerr << what << ": does not parse\n";
+      exit(1);
+   }
+   // as Program_class::semant() does, but starting afresh for each program
+   int errors = semant_headers(decls);
+   for (int i = decls->first(); decls->more(i); i = decls->next(i))
+      errors += semant_check(decls->nth(i));
+   if (errors != 0) {
+      cerr << what << ": does not check\n";
+      exit(1);
+   }
+
+   std::ostringstream text;
+   program->dump_with_types(text, 0);
+   std::string s = text.str();
+   long bytes = s.size(), lines = 0;
+   for (size_t i = 0; i < s.size(); i++)
+      lines += s[i] == '\n';
+
+   std::ofstream null("/dev/null");
+   double best = 0;
+   for (int i = 0; i < 3; i++) {
+      double start = now();
+      program->dump_with_types(null, 0);
+      double secs = now() - start;
+      if (i == 0 || secs < best)
+         best = secs;
+   }
+   printf("%-5s %10ld lines %11ld bytes %8.3f s %8.1f Mlines/s %8.1f MB/s\n",
+          what, lines, bytes, best, lines / best / 1e6, bytes / best / 1e6);
+}
+
+int main(int argc, char *argv[])
+{
+   int functions = argc > 1 ? atoi(argv[1]) : 20000;
+   int depth = argc > 2 ? atoi(argv[2]) : 30;
+   yy_flex_debug = 0;
+
+   FILE *wide = tmpfile(), *deep = tmpfile();
+   if (wide == NULL || deep == NULL) {
+      perror("tmpfile");
+      return 1;
+   }
+   make_wide(wide, functions);
+   make_deep(deep, functions / 20 > 0 ? functions / 20 : 1, depth);
+   bench("wide", wide);
+   bench("deep", deep);
+   return 0;
+}
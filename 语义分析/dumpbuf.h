@@ -0,0 +1,71 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _DUMPBUF_H_
+#define _DUMPBUF_H_
+
+#include <string.h>
+#include "seal-io.h"
+#include "stringtab.h"
+
+//
+// DumpBuffer: where dump_with_types writes the typed AST.
+//
+//    The text goes into one large buffer and is written to the stream
+//    only when the buffer is full and when the DumpBuffer is flushed or
+//    destroyed, so there is no per-line work in the stream and nothing is
+//    allocated after the buffer itself.
+//
+//    `b << indent(n)' writes n blanks, for any n; unlike pad(), which
+//        stops at 80, deep trees keep their shape.
+//
+//    `b << s' writes a string, a Symbol's string, or an int in decimal,
+//        as an ostream would.
+//
+struct Indent { int n; };
+
+inline Indent indent(int n) { Indent i = { n }; return i; }
+
+class DumpBuffer {
+private:
+   ostream &out;
+   char *buf, *at, *end;
+
+   void spill();                           // write out what is buffered
+
+   DumpBuffer(const DumpBuffer &);         // not copyable
+   DumpBuffer &operator =(const DumpBuffer &);
+
+   // room for n more bytes, or false if they do not fit even when empty
+   bool room(size_t n)
+   {
+      if (n <= (size_t) (end - at))
+         return true;
+      spill();
+      return n <= (size_t) (end - at);
+   }
+public:
+   DumpBuffer(ostream &out, size_t size = 1 << 20);
+   ~DumpBuffer();
+   void flush();
+
+   void write(const char *s, size_t n)
+   {
+      if (!room(n)) {
+         out.write(s, n);
+         return;
+      }
+      memcpy(at, s, n);
+      at += n;
+   }
+
+   DumpBuffer &operator <<(const char *s) { write(s, strlen(s)); return *this; }
+   DumpBuffer &operator <<(Symbol s) { return *this << s->get_string(); }
+   DumpBuffer &operator <<(int i);
+   DumpBuffer &operator <<(Indent i);
+};
+
+#endif
@@ -10,6 +10,135 @@ for filename in *.seal; do
     else
         echo NOT passed
     fi
+    # the same, parsed from the token stream saved with -k
+    ../semant -k $filename > /dev/null 2>&1
+    ../semant ${filename}tok > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (tokens)"
+    else
+        echo "NOT passed (tokens)"
+    fi
+    rm -f ${filename}tok
+    # and read from a pipe, which is neither mapped nor a token stream
+    cat $filename | ../semant /dev/stdin > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (piped)"
+    else
+        echo "NOT passed (piped)"
+    fi
+    # and pushed to the parser through a pipe as it is read, with -i
+    cat $filename | ../semant -i /dev/stdin > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (streamed)"
+    else
+        echo "NOT passed (streamed)"
+    fi
+    # and with the function bodies checked on four threads, with -J
+    ../semant -J 4 $filename > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (parallel)"
+    else
+        echo "NOT passed (parallel)"
+    fi
+    # and compiled in one session, as an edit of the test before it, with -e
+    ../semant -e ${previous:-$filename} $filename > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (session)"
+    else
+        echo "NOT passed (session)"
+    fi
+    # and loaded from the typed AST saved by a first run with -a
+    ../semant -a $filename > /dev/null 2>&1
+    ../semant -s -a $filename 2>tempfile.err > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ] && grep -q "typed AST loaded" tempfile.err; then
+        echo "Passed (cached)"
+    else
+        echo "NOT passed (cached)"
+    fi
+    rm -f ${filename}ast tempfile.err
+    # and with -a from a pipe, which is compiled without the cache
+    cat $filename | ../semant -a /dev/stdin > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (cached, piped)"
+    else
+        echo "NOT passed (cached, piped)"
+    fi
+    previous=$filename
 done
 rm -f tempfile
 cd ..
+
+# edits compiled in one session with -e, against a full compile of the
+# last version: a function's signature changes in NAME-2.seal, and its
+# callers, which are not edited, must be checked and typed anew
+cd test-edit
+for filename in *-2.seal; do
+    first=${filename%-2.seal}-1.seal
+    echo "--------Edit" $first "to" $filename "--------"
+    ../semant $filename > tempfile.full 2>&1
+    ../semant -e $first $filename > tempfile 2>&1
+    diff tempfile tempfile.full > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (edit)"
+    else
+        echo "NOT passed (edit)"
+    fi
+done
+rm -f tempfile tempfile.full
+cd ..
+
+# what the checker accepts and rejects in calls, printf, unary minus and
+# break and continue, by all semant writes
+cd test-check
+for filename in *.seal; do
+    echo "--------Check" $filename "--------"
+    ../semant $filename > tempfile 2>&1
+    diff tempfile ../test-check-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (check)"
+    else
+        echo "NOT passed (check)"
+    fi
+done
+rm -f tempfile
+cd ..
+
+# programs run in the bytecode virtual machine with -x, by their output
+cd test-run
+for filename in *.seal; do
+    echo "--------Run" $filename "--------"
+    ../semant -x $filename > tempfile
+    diff tempfile ../test-run-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "Passed (run)"
+    else
+        echo "NOT passed (run)"
+    fi
+done
+rm -f tempfile
+cd ..
+
+# and built as executables with -o, by the same output, with registers
+# allocated and with -r without
+cd test-run
+for filename in *.seal; do
+    echo "--------Build" $filename "--------"
+    for flag in "" -r; do
+        ../semant $flag -o tempfile $filename && ./tempfile > tempfile.out
+        diff tempfile.out ../test-run-answer/$filename.out > /dev/null
+        if [ $? -eq 0 ]; then
+            echo "Passed (native${flag:+ $flag})"
+        else
+            echo "NOT passed (native${flag:+ $flag})"
+        fi
+    done
+done
+rm -f tempfile tempfile.out
+cd ..
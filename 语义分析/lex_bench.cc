@@ -0,0 +1,155 @@
+//
+// lex_bench.cc
+//
+// Times the scanner alone over a large source file, once reading the file
+// through stdio into flex's buffer and once scanning a memory mapping of
+// it in place, and then the scanner and parser together over the mapping,
+// building the whole AST, and reports the throughput of each in MB/s.
+//
+//    % make lex_bench
+//    % ./lex_bench [megabytes | file.seal ...]
+//
+// With no file arguments a synthetic source of the given size (default
+// 64 MB) is generated into a temporary file first.  Each mode is run
+// three times over each file and the best time is reported, so the page
+// cache is warm for both.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "compilation.h"
+
+extern int yy_flex_debug;
+
+static double now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//
+// Write about "bytes" bytes of generated code: functions with
+// declarations, arithmetic, calls, string and float constants, with a
+// bounded set of names as real programs have, and with the indentation
+// and comments of machine-generated code.
+//
+static void make_source(FILE *f, long bytes)
+{
+   unsigned seed = 12345;
+   for (int n = 0; ftell(f) < bytes; n++) {
+      seed = seed * 1103515245 + 12345;
+      int v = (seed >> 8) % 1000;
+      fprintf(f,
+              "/*\n"
+              " * function %d\n"
+              " *\n"
+              " * generated; do not edit\n"
+              " */\n"
+              "Int func f_%d(Int a_%d, Float b_%d) {\n"
+              "        Int x_%d;\n"
+              "        String s_%d;\n"
+              "        x_%d = a_%d * %d + (a_%d - %d) / 7 %% 3;\n"
+              "        s_%d = \"value of x is %%d\\n\";\n"
+              "        // loop until done\n"
+              "        while x_%d < %d && x_%d != 0 {\n"
+              "                x_%d = x_%d + f_%d(x_%d, b_%d * %d.5);\n"
+              "        }\n"
+              "        if x_%d >= %d || !true { return x_%d & 255; }\n"
+              "        return ~x_%d ^ %d;\n"
+              "}\n\n",
+              n, n, v, v, v, v, v, v, n, v, n,
+              v, v, n, v, v, v, v, v, v, n,
+              v, n, v, v, n);
+   }
+}
+
+enum Mode { STDIO, MMAP, PARSE };
+
+//
+// Scan, or scan and parse, the whole of f once; returns the number of
+// tokens scanned, or 0 for a parse.
+//
+static long scan(FILE *f, char *name, Mode mode)
+{
+   rewind(f);
+   CompilationContext ctx(f, name);
+   if (mode != STDIO && !ctx.map_input()) {
+      cerr << name << ": cannot be mapped\n";
+      exit(1);
+   }
+   if (mode == PARSE) {
+      if (ctx.parse() == NULL) {
+         cerr << name << ": does not parse\n";
+         exit(1);
+      }
+      return 0;
+   }
+   YYSTYPE value;
+   long tokens = 0;
+   while (seal_yyscan(&value, &ctx) != 0)
+      tokens++;
+   seal_yyscan_reset();
+   return tokens;
+}
+
+// tokens is the number of tokens in f; the scans count them into it
+static void run(const char *what, FILE *f, char *name, long bytes, Mode mode,
+                long &tokens)
+{
+   double best = 0;
+   for (int i = 0; i < 3; i++) {
+      double start = now();
+      long n = scan(f, name, mode);
+      if (mode != PARSE)
+         tokens = n;
+      double secs = now() - start;
+      if (i == 0 || secs < best)
+         best = secs;
+   }
+   printf("%-8s %10ld bytes %9ld tokens %8.3f s %8.1f MB/s %6.1f Mtok/s\n",
+          what, bytes, tokens, best, bytes / best / 1e6, tokens / best / 1e6);
+}
+
+static void bench(FILE *f, char *name)
+{
+   fseek(f, 0, SEEK_END);
+   long bytes = ftell(f);
+   printf("%s\n", name);
+   long tokens = 0;
+   run("stdio", f, name, bytes, STDIO, tokens);
+   run("mmap", f, name, bytes, MMAP, tokens);
+   run("parse", f, name, bytes, PARSE, tokens);
+}
+
+int main(int argc, char *argv[])
+{
+   yy_flex_debug = 0;
+
+   if (argc <= 1 || atof(argv[1]) > 0) {
+      long megabytes = argc > 1 ? atol(argv[1]) : 64;
+      FILE *f = tmpfile();
+      if (f == NULL) {
+         perror("tmpfile");
+         return 1;
+      }
+      make_source(f, megabytes << 20);
+      fflush(f);
+      bench(f, (char *) "<generated>");
+      fclose(f);
+      return 0;
+   }
+
+   for (int i = 1; i < argc; i++) {
+      FILE *f = fopen(argv[i], "r");
+      if (f == NULL) {
+         cerr << "Could not open input file " << argv[i] << endl;
+         return 1;
+      }
+      bench(f, argv[i]);
+      fclose(f);
+   }
+   return 0;
+}
@@ -0,0 +1,393 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: regalloc.cc
+//
+// Linear-scan register allocation (Poletto and Sarkar) for the native
+// code generator.  Each bytecode register gets one live interval, from
+// the first instruction it is live at to the last, loops included; the
+// intervals are visited by start, and each takes a free machine
+// register or, with none free, the register of the interval it may
+// take one from that is cheapest to leave in memory, itself included.
+// That interval goes to a stack slot for all of its length, and the
+// code generator loads and stores it around each instruction using it.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include <sstream>
+#include "cgen.h"
+
+//
+// The registers handed out, by how much a call disturbs them.  Calls,
+// including those to printf and strcmp, load the argument registers
+// and do not keep any but the callee-saved ones, and the parameters
+// arrive in the argument registers; %rax, %rcx and %rdx are the code
+// generator's own.  So an interval live across a call needs a
+// callee-saved register, one at a call or a parameter any but the
+// argument registers, and any other one whatever is free.
+//
+static const char *const machine[] = {
+    "%rsi", "%rdi", "%r8", "%r9",               // argument registers
+    "%r10", "%r11",                             // caller-saved
+    "%rbx", "%r12", "%r13", "%r14", "%r15",     // callee-saved
+};
+enum { CALLER_SAVED = 4, CALLEE_SAVED = 6, MACHINE = 11 };
+
+// the registers instruction in reads into uses, and the one it sets, or -1
+static int operands(const Bytecode &program, const Insn &in, std::vector<int> &uses)
+{
+    uses.clear();
+    switch (in.op) {
+    case OP_LOADI:
+    case OP_LOADK:
+    case OP_LOADF:
+    case OP_LOADS:
+    case OP_GETG:
+        return in.a;
+    case OP_SETG:
+        uses.push_back(in.b);
+        return -1;
+    case OP_MOV:
+    case OP_ADDI:
+    case OP_NEG:
+    case OP_NEGF:
+    case OP_I2F:
+    case OP_BNOT:
+    case OP_NOT:
+        uses.push_back(in.b);
+        return in.a;
+    case OP_JMP:
+    case OP_RETV:
+        return -1;
+    case OP_JT:
+    case OP_JF:
+    case OP_JLTI:
+    case OP_JLEI:
+    case OP_JGTI:
+    case OP_JGEI:
+    case OP_JEQI:
+    case OP_JNEI:
+    case OP_RET:
+        uses.push_back(in.a);
+        return -1;
+    case OP_JLT:
+    case OP_JLE:
+    case OP_JEQ:
+    case OP_JNE:
+        uses.push_back(in.a);
+        uses.push_back(in.b);
+        return -1;
+    case OP_CALL:
+        for (int i = 0; i < program.functions[in.b].params; i++)
+            uses.push_back(in.c + i);
+        return in.a;
+    case OP_PRINTF:
+        for (int i = 0; i < in.b; i++)
+            uses.push_back(in.a + i);
+        return -1;
+    default:                            // the rest have b and c
+        uses.push_back(in.b);
+        uses.push_back(in.c);
+        return in.a;
+    }
+}
+
+static bool calls(int op)
+{
+    return op == OP_CALL || op == OP_PRINTF || (op >= OP_LTS && op <= OP_NES);
+}
+
+static bool jumps(int op)
+{
+    return op >= OP_JMP && op <= OP_JNEI;
+}
+
+static std::string slot(int n)
+{
+    std::ostringstream s;
+    s << -8 * (n + 1) << "(%rbp)";
+    return s.str();
+}
+
+//
+// Live intervals.  Instruction i is at position 2i, where it both reads
+// and writes, so no two registers an instruction touches share a
+// machine register; 2i+1 is between it and the next.  The parameters
+// start at -1, as they arrive.
+//
+class Intervals {
+private:
+    const Bytecode &program;
+    const BytecodeFunction &fn;
+    std::vector<int> block;             // of each instruction
+    std::vector<int> first, last;       // instructions of each block
+    std::vector<std::vector<int> > preds;
+    std::vector<std::vector<int> > defs;        // of each register, in order
+    std::vector<std::vector<int> > used;
+
+    void blocks();
+    bool sets(int r, int from, int to);
+    void extend(int r, int position)
+    {
+        start[r] = std::min(start[r], position);
+        end[r] = std::max(end[r], position);
+    }
+    void live_in(int r, int b, std::vector<int> &in_mark, std::vector<int> &out_mark);
+    bool used_after(int r, int i, const std::vector<int> &out_mark);
+public:
+    std::vector<bool> dead;             // instructions setting values never used
+    std::vector<int> start, end;        // INT_MAX and -1 if never used
+    std::vector<int> call_at;           // positions of calls
+    std::vector<double> cost;           // of each register in memory
+
+    Intervals(const Bytecode &p, const BytecodeFunction &f);
+    bool crosses_call(int r);
+    bool meets_call(int r);
+};
+
+void Intervals::blocks()
+{
+    int n = fn.code.size();
+    std::vector<bool> leader(n + 1, false);
+    leader[0] = true;
+    for (int i = 0; i < n; i++) {
+        const Insn &in = fn.code[i];
+        if (jumps(in.op))
+            leader[in.c] = true;
+        if (jumps(in.op) || in.op == OP_RET || in.op == OP_RETV)
+            leader[i + 1] = true;
+    }
+    for (int i = 0; i < n; i++) {
+        if (leader[i]) {
+            if (!first.empty())
+                last.push_back(i - 1);
+            first.push_back(i);
+        }
+        block.push_back(first.size() - 1);
+    }
+    if (n > 0)
+        last.push_back(n - 1);
+    preds.resize(first.size());
+    for (size_t b = 0; b < first.size(); b++) {
+        const Insn &in = fn.code[last[b]];
+        if (jumps(in.op))
+            preds[block[in.c]].push_back(b);
+        if (in.op != OP_JMP && in.op != OP_RET && in.op != OP_RETV && last[b] + 1 < n)
+            preds[b + 1].push_back(b);
+    }
+}
+
+// whether r is set by an instruction from to to
+bool Intervals::sets(int r, int from, int to)
+{
+    std::vector<int>::const_iterator d = std::lower_bound(defs[r].begin(), defs[r].end(), from);
+    return d != defs[r].end() && *d <= to;
+}
+
+//
+// r is live into block b: so it is live out of b's predecessors, and
+// into those that do not set it.  The marks say for which register a
+// block has been seen, so they need no clearing between registers.
+//
+void Intervals::live_in(int r, int b, std::vector<int> &in_mark, std::vector<int> &out_mark)
+{
+    std::vector<int> work(1, b);
+    while (!work.empty()) {
+        b = work.back();
+        work.pop_back();
+        if (in_mark[b] == r)
+            continue;
+        in_mark[b] = r;
+        extend(r, 2 * first[b]);
+        for (size_t p = 0; p < preds[b].size(); p++) {
+            int pred = preds[b][p];
+            if (out_mark[pred] == r)
+                continue;
+            out_mark[pred] = r;
+            extend(r, 2 * last[pred] + 1);
+            if (!sets(r, first[pred], last[pred]))
+                work.push_back(pred);
+        }
+    }
+}
+
+Intervals::Intervals(const Bytecode &p, const BytecodeFunction &f)
+    : program(p), fn(f), defs(f.regs), used(f.regs),
+      start(f.regs, INT_MAX), end(f.regs, -1), cost(f.regs, 0)
+{
+    blocks();
+
+    // a loop is the code from a jump back to its target; each use in it
+    // counts ten times one outside
+    int n = fn.code.size();
+    std::vector<int> loops(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        const Insn &in = fn.code[i];
+        if (jumps(in.op) && in.c <= i) {
+            loops[in.c]++;
+            loops[i + 1]--;
+        }
+    }
+    std::vector<int> uses;
+    double weight = 1;
+    for (int i = 0, depth = 0; i < n; i++) {
+        if (loops[i] != 0) {
+            depth += loops[i];
+            weight = pow(10, std::min(depth, 8));
+        }
+        int def = operands(program, fn.code[i], uses);
+        if (def >= 0) {
+            defs[def].push_back(i);
+            cost[def] += weight;
+        }
+        for (size_t u = 0; u < uses.size(); u++) {
+            used[uses[u]].push_back(i);
+            extend(uses[u], 2 * i);
+            cost[uses[u]] += weight;
+        }
+        if (calls(fn.code[i].op))
+            call_at.push_back(2 * i);
+    }
+    for (int r = 0; r < fn.params; r++)
+        extend(r, -1);
+
+    dead.assign(n, false);
+    std::vector<int> in_mark(first.size(), -1), out_mark(first.size(), -1);
+    for (int r = 0; r < fn.regs; r++) {
+        for (size_t u = 0; u < used[r].size(); u++) {
+            int i = used[r][u], b = block[i];
+            if (!sets(r, first[b], i - 1))
+                live_in(r, b, in_mark, out_mark);
+        }
+        // a value never used need not be computed, if computing it does
+        // nothing else
+        for (size_t d = 0; d < defs[r].size(); d++) {
+            int i = defs[r][d];
+            int op = fn.code[i].op;
+            if (used_after(r, i, out_mark) || op == OP_CALL || op == OP_DIV || op == OP_MOD)
+                extend(r, 2 * i);
+            else
+                dead[i] = true;
+        }
+    }
+}
+
+// whether the value instruction i sets r to is used
+bool Intervals::used_after(int r, int i, const std::vector<int> &out_mark)
+{
+    int b = block[i];
+    std::vector<int>::const_iterator u = std::upper_bound(used[r].begin(), used[r].end(), i);
+    std::vector<int>::const_iterator d = std::upper_bound(defs[r].begin(), defs[r].end(), i);
+    int next_use = u != used[r].end() ? *u : INT_MAX;
+    int next_def = d != defs[r].end() ? *d : INT_MAX;
+    if (next_use <= last[b] && next_use <= next_def)
+        return true;                    // read, perhaps by the next to set it
+    if (next_def <= last[b])
+        return false;
+    return out_mark[b] == r;
+}
+
+// whether r must live through a call
+bool Intervals::crosses_call(int r)
+{
+    std::vector<int>::const_iterator c = std::upper_bound(call_at.begin(), call_at.end(), start[r]);
+    return c != call_at.end() && *c < end[r];
+}
+
+// whether r is read or set by a call, or is a parameter
+bool Intervals::meets_call(int r)
+{
+    std::vector<int>::const_iterator c = std::lower_bound(call_at.begin(), call_at.end(), start[r]);
+    return start[r] < 0 || (c != call_at.end() && *c <= end[r]);
+}
+
+// orders registers by where their intervals start
+struct Earlier {
+    const std::vector<int> &start;
+    Earlier(const std::vector<int> &s) : start(s) { }
+    bool operator()(int r, int s) const
+    {
+        return start[r] < start[s] || (start[r] == start[s] && r < s);
+    }
+};
+
+void allocate_registers(Bytecode &program, int f, Allocation &allocation)
+{
+    BytecodeFunction &fn = program.functions[f];
+    allocation.where.assign(fn.regs, "");
+    allocation.dead.assign(fn.code.size(), false);
+    allocation.saved.clear();
+    allocation.in_registers = allocation.spilled = 0;
+    if (disable_reg_alloc) {            // -r: each register in its slot
+        for (int r = 0; r < fn.regs; r++)
+            allocation.where[r] = slot(r);
+        allocation.frame = (8 * fn.regs + 15) / 16 * 16;
+        allocation.spilled = fn.regs;
+        return;
+    }
+
+    Intervals live(program, fn);
+    allocation.dead = live.dead;
+    std::vector<int> order;
+    for (int r = 0; r < fn.regs; r++) {
+        if (live.end[r] >= 0 || live.start[r] < 0)
+            order.push_back(r);
+    }
+    std::sort(order.begin(), order.end(), Earlier(live.start));
+
+    std::vector<int> holder(MACHINE, -1);       // interval in each register
+    std::vector<int> given(fn.regs, -1);        // register of each interval
+    for (size_t i = 0; i < order.size(); i++) {
+        int r = order[i];
+        for (int m = 0; m < MACHINE; m++) {     // those ended are free
+            if (holder[m] >= 0 && live.end[holder[m]] < live.start[r])
+                holder[m] = -1;
+        }
+        int lowest = live.crosses_call(r) ? CALLEE_SAVED :
+                     live.meets_call(r) ? CALLER_SAVED : 0;
+        int free = -1, cheapest = -1;
+        for (int m = lowest; m < MACHINE && free < 0; m++) {
+            if (holder[m] < 0)
+                free = m;
+            else if (cheapest < 0 || live.cost[holder[m]] < live.cost[holder[cheapest]])
+                cheapest = m;
+        }
+        if (free < 0) {
+            if (cheapest < 0 || live.cost[holder[cheapest]] >= live.cost[r])
+                continue;                       // r is spilled
+            given[holder[cheapest]] = -1;       // the other is
+            free = cheapest;
+        }
+        holder[free] = r;
+        given[r] = free;
+    }
+
+    std::vector<bool> saving(MACHINE, false);
+    for (size_t i = 0; i < order.size(); i++) {
+        int m = given[order[i]];
+        if (m >= CALLEE_SAVED && !saving[m]) {
+            saving[m] = true;
+            allocation.saved.push_back(machine[m]);
+        }
+    }
+    int slots = allocation.saved.size();
+    for (size_t i = 0; i < order.size(); i++) {
+        int r = order[i];
+        if (given[r] >= 0) {
+            allocation.where[r] = machine[given[r]];
+            allocation.in_registers++;
+        } else {
+            allocation.where[r] = slot(slots++);
+            allocation.spilled++;
+        }
+    }
+    allocation.frame = (8 * slots + 15) / 16 * 16;
+}
@@ -11,7 +11,9 @@ class Decl_class : public tree_node {
 public:
     tree_node *copy()		 { return copy_Decl(); }
     virtual Decl copy_Decl() = 0;
-    virtual void dump_with_types(ostream&,int) = 0; 
+    virtual void dump_with_types(DumpBuffer&,int) = 0; 
+    virtual void save(AstWriter&) = 0;
+    virtual void code(BytecodeGen&) = 0;
     virtual void dump(ostream&,int) = 0;
     virtual bool isCallDecl() = 0;
     virtual Symbol getName() = 0;
@@ -35,7 +37,8 @@ public:
    
    Variable copy_Variable();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
+   void dump_with_types(DumpBuffer&,int);
+   void save(AstWriter&);
 };
 
 class VariableDecl_class : public Decl_class {
@@ -51,7 +54,9 @@ public:
    Decl copy_Decl();
    void check();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
+   void dump_with_types(DumpBuffer&,int);
+   void save(AstWriter&);
+   void code(BytecodeGen&);
    bool isCallDecl(){return false;};   
 };
 
@@ -63,11 +68,13 @@ protected:
     StmtBlock body;
     
 public:
+   int locals;                       // local variable slots, set by check
    CallDecl_class(Symbol a1, Variables a2, Symbol a3, StmtBlock a4) {
       name = a1;
       paras = a2;
       returnType = a3;
       body = a4;
+      locals = 0;
    }
    
    Symbol getName(){return name;}
@@ -78,7 +85,9 @@ public:
    Decl copy_Decl();
    void check();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
+   void dump_with_types(DumpBuffer&,int);
+   void save(AstWriter&);
+   void code(BytecodeGen&);
    bool isCallDecl(){return true;}
 };
 
@@ -99,12 +108,15 @@ typedef Variables_class *Variables;
 Decls nil_Decls();
 Decls single_Decls(Decl);
 Decls append_Decls(Decls,Decls);
+Decls add_Decls(Decls,Decl);
 VariableDecls nil_VariableDecls();
 VariableDecls single_VariableDecls(VariableDecl);
 VariableDecls append_VariableDecls(VariableDecls,VariableDecls);
+VariableDecls add_VariableDecls(VariableDecls,VariableDecl);
 Variables nil_Variables();
 Variables single_Variables(Variable);
 Variables append_Variables(Variables,Variables);
+Variables add_Variables(Variables,Variable);
 
 VariableDecl variableDecl(Variable);
 Variable variable(Symbol,Symbol);
@@ -376,6 +376,10 @@ Exprs append_Exprs(Exprs p1, Exprs p2)
 {
    return new append_node<Expr>(p1, p2);
 }
+Exprs add_Exprs(Exprs l, Expr e)
+{
+   return l->add(e);
+}
 
 
 Actuals nil_Actuals()
@@ -390,6 +394,10 @@ Actuals append_Actuals(Actuals p1, Actuals p2)
 {
    return new append_node<Actual>(p1, p2);
 }
+Actuals add_Actuals(Actuals l, Actual e)
+{
+   return l->add(e);
+}
 
 
 Expr assign(Symbol a1, Expr a2)
@@ -6,6 +6,7 @@
 #include "seal-tree.handcode.h"
 #include "seal-stmt.h"
 #include "seal-decl.h"
+#include "binding.h"
 
 typedef class Expr_class *Expr;
 typedef class Actual_class *Actual;
@@ -16,20 +17,40 @@ typedef class Call_class *Call;
 class Expr_class : public Stmt_class {
 public:     
    Symbol type;                      
+   int visits;                       // checkType calls on this node
    Symbol getType() { return type; }           
    Expr setType(Symbol s) { type = s; return this; } 
    Stmt copy_Stmt() { return copy_Expr(); }             
-   Expr_class() { type = (Symbol) NULL; }
+   Expr_class() { type = (Symbol) NULL; visits = 0; }
    Expr_class(Symbol a1) {
         type = a1;
+        visits = 0;
    }
    void check(Symbol a) {checkType();}
-   void dump_type(ostream&, int);
+   void dump_type(DumpBuffer&,int);
+
+   // The expression is typed by inferType the first time it is checked;
+   // later calls return the type cached in "type".
+   Symbol checkType() {
+        visits++;
+        if (type == NULL)
+            setType(inferType());
+        return type;
+   }
+
+   virtual void dump_with_types(DumpBuffer&,int) = 0; 
+   virtual void save(AstWriter&) = 0;
 
-   virtual void dump_with_types(ostream&,int) = 0; 
+   // code_value compiles the expression and returns the register that
+   // holds its value: dst if it is not -1, else any.  code_branch
+   // compiles a Bool one as a test, adding the jumps taken when its value
+   // is "when" to the list, and falls through otherwise (see bytecode.cc).
+   virtual int code_value(BytecodeGen&,int) = 0;
+   virtual void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   void code(BytecodeGen &g) { code_value(g, -1); }
 	virtual void dump(ostream&,int) = 0;
    virtual Expr copy_Expr() = 0;
-   virtual Symbol checkType() = 0;
+   virtual Symbol inferType() = 0;
    virtual bool is_empty_Expr() = 0;
 };
 
@@ -38,18 +59,22 @@ protected:
    Symbol name;
    Actuals actuals;
 public:
+   CallDecl callee;                  // set by inferType
    Call_class(Symbol a1, Actuals a2)  {
         name = a1;
         actuals = a2;
+        callee = NULL;
    }
    Symbol getName(){return name;}
    Actuals getActuals(){return actuals;}
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
-   void dump_with_types(ostream&,int); 
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
 	void dump(ostream&,int);
-   void dump_type(ostream& , int );
-   Symbol checkType();
+   void dump_type(DumpBuffer&,int);
+   Symbol inferType();
 };
 
 
@@ -62,10 +87,12 @@ public:
    }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
-   void dump_with_types(ostream&,int); 
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
 	void dump(ostream&,int);
-   void dump_type(ostream& , int );
-   Symbol checkType();
+   void dump_type(DumpBuffer&,int);
+   Symbol inferType();
 };
 
 // define constructor - expr
@@ -74,15 +101,21 @@ protected:
    Symbol lvalue;
    Expr value;
 public:
+   Binding binding;                  // of lvalue, set by inferType
    Assign_class(Symbol a1, Expr a2)  {
       lvalue = a1;
       value = a2;
+      binding.kind = unboundbinding;
+      binding.slot = 0;
+      binding.type = NULL;
    }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - add
@@ -98,8 +131,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - minus
@@ -115,8 +150,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - multi
@@ -132,8 +169,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
-   Symbol checkType(); 
+   void dump_with_types(DumpBuffer&,int);
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - divide
@@ -149,8 +188,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - mod
@@ -166,8 +207,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - -
@@ -181,8 +224,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - <
@@ -198,8 +243,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - <=
@@ -215,8 +263,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - ==
@@ -232,8 +283,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - !=
@@ -249,8 +303,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - >=
@@ -266,8 +323,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - >
@@ -283,8 +343,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - and &&
@@ -300,8 +363,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - or ||
@@ -317,8 +383,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - xor ^
@@ -334,8 +403,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - not !
@@ -349,8 +420,11 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 // define constructor - bitnot ~
@@ -364,8 +438,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 class Bitand_class : public Expr_class {
@@ -380,8 +456,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 class Bitor_class : public Expr_class {
@@ -396,8 +474,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructconst_int - const_int
@@ -408,11 +488,14 @@ public:
    Const_int_class(Symbol a1) {
       value = a1;
    }
+   Symbol getValue() { return value; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructconst_string - const_string
@@ -426,8 +509,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructconst_float - const_float
@@ -441,8 +526,10 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructconst_bool - const_bool
@@ -456,23 +543,32 @@ public:
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   void code_branch(BytecodeGen&,bool,std::vector<int>&);
+   Symbol inferType();
 };
 
 class Object_class : public Expr_class {
 protected:
    Symbol var;
 public:
+   Binding binding;                  // set by inferType
    Object_class(Symbol a1) {
       var = a1;
+      binding.kind = unboundbinding;
+      binding.slot = 0;
+      binding.type = NULL;
    }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr(){return copy_Object();};
    Object copy_Object();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 // define constructor - no_expr
@@ -484,8 +580,10 @@ public:
    bool is_empty_Expr(){ return true;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
+   void dump_with_types(DumpBuffer&,int); 
+   void save(AstWriter&);
+   int code_value(BytecodeGen&,int);
+   Symbol inferType();
 };
 
 
@@ -499,26 +597,31 @@ typedef Actuals_class *Actuals;
 Exprs nil_Exprs();
 Exprs single_Exprs(Expr);
 Exprs append_Exprs(Exprs,Exprs);
+Exprs add_Exprs(Exprs,Expr);
 
 
 LValues nil_LValues();
 LValues single_LValues(LValue);
 LValues append_LValues(LValues,LValues);
+LValues add_LValues(LValues,LValue);
 
 
 Calls nil_Calls();
 Calls single_Calls(Call);
 Calls append_Calls(Calls,Calls);
+Calls add_Calls(Calls,Call);
 
 
 Actuals nil_Actuals();
 Actuals single_Actuals(Actual);
 Actuals append_Actuals(Actuals,Actuals);
+Actuals add_Actuals(Actuals,Actual);
 
 
 Constants nil_Constants();
 Constants single_Constants(Constant);
 Constants append_Constants(Constants,Constants);
+Constants add_Constants(Constants,Constant);
 
 
 Expr assign(Symbol, Expr);
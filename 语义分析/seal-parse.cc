@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,20 +45,20 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
 #define YYPULL 1
@@ -61,17 +66,19 @@
 
 /* Substitute the variable and function names.  */
 #define yyparse         seal_yyparse
+#define yypush_parse    seal_yypush_parse
+#define yypull_parse    seal_yypull_parse
+#define yypstate_new    seal_yypstate_new
+#define yypstate_clear  seal_yypstate_clear
+#define yypstate_delete seal_yypstate_delete
+#define yypstate        seal_yypstate
 #define yylex           seal_yylex
 #define yyerror         seal_yyerror
 #define yydebug         seal_yydebug
 #define yynerrs         seal_yynerrs
 
-#define yylval          seal_yylval
-#define yychar          seal_yychar
-#define yylloc          seal_yylloc
-
-/* Copy the first part of user declarations.  */
-#line 6 "seal.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 6 "seal.y"
 
   #include <iostream>
   #include "seal-decl.h"
@@ -80,13 +87,13 @@
   #include "stringtab.h"
   #include "utilities.h"
 
-  extern char *curr_filename;
+  #include "compilation.h"
+
   /* Locations */
   #define YYLTYPE int              /* the type of locations */
-  #define seal_yylloc curr_lineno  /* use the curr_lineno from the lexer
-  for the location of tokens */
+  #undef YYLTYPE_IS_TRIVIAL        /* not the struct from seal-parse.h */
     
-    extern int node_lineno;          /* set before constructing a tree node
+    extern thread_local int node_lineno; /* set before constructing a tree node
     to whatever you want the line number
     for the tree node to be */
       
@@ -143,196 +150,200 @@
     
     
     
-    void yyerror(char *s);        /*  defined below; called for each parse error */
-    extern int yylex();           /*  the entry point to the lexer  */
+    /* defined below; called for each parse error */
+    void yyerror(YYLTYPE *llocp, CompilationContext *ctx, const char *s);
+    /* defined below; reads the next token for the parser */
+    static int yylex(YYSTYPE *lvalp, YYLTYPE *llocp, CompilationContext *ctx);
     
     /************************************************************************/
     /*                DONT CHANGE ANYTHING IN THIS SECTION                  */
     
-    Program ast_root;	      /* the result of the parse  */
-    //Decls parse_results;        /* for use in semantic analysis */
-    int omerrs = 0;               /* number of errors in lexing and parsing */
-    bool flag_nx = 0;
-    int flag_nx0 = 0;
-    
 
-#line 160 "seal.tab.c" /* yacc.c:339  */
+#line 163 "seal.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "seal.tab.h".  */
-#ifndef YY_SEAL_YY_SEAL_TAB_H_INCLUDED
-# define YY_SEAL_YY_SEAL_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 1
-#endif
-#if YYDEBUG
-extern int seal_yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    IF = 258,
-    ELSE = 260,
-    WHILE = 261,
-    FOR = 262,
-    BREAK = 263,
-    CONTINUE = 264,
-    FUNC = 265,
-    RETURN = 266,
-    VAR = 271,
-    AND = 274,
-    OR = 275,
-    EQUAL = 276,
-    NE = 277,
-    GE = 278,
-    LE = 279,
-    CONST_BOOL = 267,
-    CONST_INT = 268,
-    CONST_STRING = 269,
-    CONST_FLOAT = 270,
-    OBJECTID = 284,
-    TYPEID = 285,
-    UMINUS = 287
-  };
-#endif
-/* Tokens.  */
-#define IF 258
-#define ELSE 260
-#define WHILE 261
-#define FOR 262
-#define BREAK 263
-#define CONTINUE 264
-#define FUNC 265
-#define RETURN 266
-#define VAR 271
-#define AND 274
-#define OR 275
-#define EQUAL 276
-#define NE 277
-#define GE 278
-#define LE 279
-#define CONST_BOOL 267
-#define CONST_INT 268
-#define CONST_STRING 269
-#define CONST_FLOAT 270
-#define OBJECTID 284
-#define TYPEID 285
-#define UMINUS 287
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "seal.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 91 "seal.y" /* yacc.c:355  */
-
-      Boolean boolean;
-      Symbol symbol;
-      Program program;
-      Decl decl;
-      Decls decls;
-      VariableDecl variableDecl;
-      VariableDecls variableDecls;
-      Variable variable;
-      Variables variables;
-      CallDecl callDecl;
-      StmtBlock stmtBlock;
-      Stmt stmt;
-      Stmts stmts;
-      IfStmt ifStmt;
-      WhileStmt whileStmt;
-      ForStmt forStmt;
-      ReturnStmt returnStmt;
-      ContinueStmt continueStmt;
-      BreakStmt breakStmt;
-      Expr expr;
-      Exprs exprs;
-      Call call;
-      Actual actual;
-      Actuals actuals;
-      
-      char *error_msg;
-    
-
-#line 278 "seal.tab.c" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IF = 3,                         /* IF  */
+  YYSYMBOL_ELSE = 4,                       /* ELSE  */
+  YYSYMBOL_WHILE = 5,                      /* WHILE  */
+  YYSYMBOL_FOR = 6,                        /* FOR  */
+  YYSYMBOL_BREAK = 7,                      /* BREAK  */
+  YYSYMBOL_CONTINUE = 8,                   /* CONTINUE  */
+  YYSYMBOL_FUNC = 9,                       /* FUNC  */
+  YYSYMBOL_RETURN = 10,                    /* RETURN  */
+  YYSYMBOL_VAR = 11,                       /* VAR  */
+  YYSYMBOL_AND = 12,                       /* AND  */
+  YYSYMBOL_OR = 13,                        /* OR  */
+  YYSYMBOL_EQUAL = 14,                     /* EQUAL  */
+  YYSYMBOL_NE = 15,                        /* NE  */
+  YYSYMBOL_GE = 16,                        /* GE  */
+  YYSYMBOL_LE = 17,                        /* LE  */
+  YYSYMBOL_CONST_BOOL = 18,                /* CONST_BOOL  */
+  YYSYMBOL_CONST_INT = 19,                 /* CONST_INT  */
+  YYSYMBOL_CONST_STRING = 20,              /* CONST_STRING  */
+  YYSYMBOL_CONST_FLOAT = 21,               /* CONST_FLOAT  */
+  YYSYMBOL_OBJECTID = 22,                  /* OBJECTID  */
+  YYSYMBOL_TYPEID = 23,                    /* TYPEID  */
+  YYSYMBOL_UMINUS = 24,                    /* UMINUS  */
+  YYSYMBOL_25_ = 25,                       /* '='  */
+  YYSYMBOL_26_ = 26,                       /* '<'  */
+  YYSYMBOL_27_ = 27,                       /* '>'  */
+  YYSYMBOL_28_ = 28,                       /* '+'  */
+  YYSYMBOL_29_ = 29,                       /* '-'  */
+  YYSYMBOL_30_ = 30,                       /* '*'  */
+  YYSYMBOL_31_ = 31,                       /* '/'  */
+  YYSYMBOL_32_ = 32,                       /* '%'  */
+  YYSYMBOL_33_ = 33,                       /* '!'  */
+  YYSYMBOL_34_ = 34,                       /* '~'  */
+  YYSYMBOL_35_ = 35,                       /* '&'  */
+  YYSYMBOL_36_ = 36,                       /* '|'  */
+  YYSYMBOL_37_ = 37,                       /* '^'  */
+  YYSYMBOL_38_ = 38,                       /* ';'  */
+  YYSYMBOL_39_ = 39,                       /* ','  */
+  YYSYMBOL_40_ = 40,                       /* '('  */
+  YYSYMBOL_41_ = 41,                       /* ')'  */
+  YYSYMBOL_42_ = 42,                       /* '{'  */
+  YYSYMBOL_43_ = 43,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 44,                  /* $accept  */
+  YYSYMBOL_program = 45,                   /* program  */
+  YYSYMBOL_decl = 46,                      /* decl  */
+  YYSYMBOL_decl_list = 47,                 /* decl_list  */
+  YYSYMBOL_variableDecl = 48,              /* variableDecl  */
+  YYSYMBOL_variableDecl_list = 49,         /* variableDecl_list  */
+  YYSYMBOL_variable = 50,                  /* variable  */
+  YYSYMBOL_variable_list = 51,             /* variable_list  */
+  YYSYMBOL_callDecl = 52,                  /* callDecl  */
+  YYSYMBOL_stmtBlock = 53,                 /* stmtBlock  */
+  YYSYMBOL_stmt = 54,                      /* stmt  */
+  YYSYMBOL_stmt_list = 55,                 /* stmt_list  */
+  YYSYMBOL_ifStmt = 56,                    /* ifStmt  */
+  YYSYMBOL_whileStmt = 57,                 /* whileStmt  */
+  YYSYMBOL_forStmt = 58,                   /* forStmt  */
+  YYSYMBOL_breakStmt = 59,                 /* breakStmt  */
+  YYSYMBOL_continueStmt = 60,              /* continueStmt  */
+  YYSYMBOL_returnStmt = 61,                /* returnStmt  */
+  YYSYMBOL_expr = 62,                      /* expr  */
+  YYSYMBOL_call = 63,                      /* call  */
+  YYSYMBOL_actual = 64,                    /* actual  */
+  YYSYMBOL_actual_list = 65                /* actual_list  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
 
 
-extern YYSTYPE seal_yylval;
-extern YYLTYPE seal_yylloc;
-int seal_yyparse (void);
+#ifdef short
+# undef short
+#endif
 
-#endif /* !YY_SEAL_YY_SEAL_TAB_H_INCLUDED  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#line 309 "seal.tab.c" /* yacc.c:358  */
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -340,15 +351,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -362,47 +386,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -415,34 +435,24 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
 
 # ifdef YYSTACK_ALLOC
    /* Pacify GCC's 'empty if-body' warning.  */
@@ -481,8 +491,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -492,18 +501,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -516,11 +526,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -532,12 +542,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -560,17 +570,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  141
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   287
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -604,63 +617,63 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   187,   187,   192,   195,   200,   203,   209,   214,   217,
-     222,   226,   229,   235,   238,   243,   246,   249,   252,   257,
-     260,   263,   266,   269,   272,   275,   278,   281,   286,   289,
-     294,   297,   302,   307,   310,   313,   316,   319,   322,   325,
-     328,   333,   338,   343,   346,   351,   354,   357,   360,   363,
-     366,   369,   372,   375,   378,   381,   384,   387,   390,   393,
-     396,   399,   402,   405,   408,   411,   414,   417,   420,   423,
-     426,   429,   434,   437,   442,   446,   449
+       0,   190,   190,   196,   199,   207,   212,   219,   224,   227,
+     232,   237,   240,   245,   248,   253,   256,   259,   262,   267,
+     270,   273,   276,   279,   282,   285,   288,   291,   296,   299,
+     304,   307,   312,   317,   320,   323,   326,   329,   332,   335,
+     338,   343,   348,   353,   356,   361,   364,   367,   370,   373,
+     376,   379,   382,   385,   388,   391,   394,   397,   400,   403,
+     406,   409,   412,   415,   418,   421,   424,   427,   430,   433,
+     436,   439,   444,   447,   452,   457,   460
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "IF", "ELSE", "WHILE", "FOR", "BREAK",
-  "CONTINUE", "FUNC", "RETURN", "VAR", "AND", "OR", "EQUAL", "NE", "GE",
-  "LE", "CONST_BOOL", "CONST_INT", "CONST_STRING", "CONST_FLOAT",
-  "OBJECTID", "TYPEID", "UMINUS", "'='", "'<'", "'>'", "'+'", "'-'", "'*'",
-  "'/'", "'%'", "'!'", "'~'", "'&'", "'|'", "'^'", "';'", "','", "'('",
-  "')'", "'{'", "'}'", "$accept", "program", "decl", "decl_list",
-  "variableDecl", "variableDecl_list", "variable", "variable_list",
-  "callDecl", "stmtBlock", "stmt", "stmt_list", "ifStmt", "whileStmt",
-  "forStmt", "breakStmt", "continueStmt", "returnStmt", "expr", "call",
-  "actual", "actual_list", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "IF", "ELSE", "WHILE",
+  "FOR", "BREAK", "CONTINUE", "FUNC", "RETURN", "VAR", "AND", "OR",
+  "EQUAL", "NE", "GE", "LE", "CONST_BOOL", "CONST_INT", "CONST_STRING",
+  "CONST_FLOAT", "OBJECTID", "TYPEID", "UMINUS", "'='", "'<'", "'>'",
+  "'+'", "'-'", "'*'", "'/'", "'%'", "'!'", "'~'", "'&'", "'|'", "'^'",
+  "';'", "','", "'('", "')'", "'{'", "'}'", "$accept", "program", "decl",
+  "decl_list", "variableDecl", "variableDecl_list", "variable",
+  "variable_list", "callDecl", "stmtBlock", "stmt", "stmt_list", "ifStmt",
+  "whileStmt", "forStmt", "breakStmt", "continueStmt", "returnStmt",
+  "expr", "call", "actual", "actual_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   286,   258,   260,   261,   262,   263,   264,   265,
-     266,   271,   274,   275,   276,   277,   278,   279,   267,   268,
-     269,   270,   284,   285,   287,    61,    60,    62,    43,    45,
-      42,    47,    37,    33,   126,    38,   124,    94,    59,    44,
-      40,    41,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -44
+#define YYPACT_NINF (-44)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-44)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
-  (!!((Yytable_value) == (-1)))
+#define yytable_value_is_error(Yyn) \
+  ((Yyn) == YYTABLE_NINF)
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
       -2,     9,    25,   -44,    -2,   -44,   -12,   -44,    11,   -44,
@@ -680,10 +693,10 @@ static const yytype_int16 yypact[] =
      -44
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     5,     2,     3,     0,     4,     0,    10,
        1,     6,     7,     0,     0,     0,     0,    11,     0,     0,
@@ -702,7 +715,7 @@ static const yytype_uint8 yydefact[] =
       33
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -44,   -44,    71,   -44,   -14,   -44,     8,   -44,   -44,   -16,
@@ -710,17 +723,17 @@ static const yytype_int8 yypgoto[] =
      -39,   -44
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     2,     3,     4,     5,    41,     6,    18,     7,    42,
+       0,     2,     3,     4,     5,    41,     6,    18,     7,    42,
       43,    44,    45,    46,    47,    48,    49,    50,    51,    52,
      100,   101
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       20,    73,    55,    56,    58,    40,    54,    62,    29,    30,
@@ -865,9 +878,9 @@ static const yytype_int16 yycheck[] =
       32,    -1,    -1,    35,    36,    37
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    23,    45,    46,    47,    48,    50,    52,     9,    22,
        0,    46,    38,    22,    40,    23,    41,    50,    51,    42,
@@ -886,8 +899,8 @@ static const yytype_uint8 yystos[] =
       53
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    44,    45,    46,    46,    47,    47,    48,    49,    49,
       50,    51,    51,    52,    52,    53,    53,    53,    53,    54,
@@ -899,8 +912,8 @@ static const yytype_uint8 yyr1[] =
       62,    62,    63,    63,    64,    65,    65
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     1,     1,     1,     2,     2,     1,     2,
        2,     1,     3,     7,     6,     4,     3,     3,     2,     1,
@@ -913,39 +926,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -989,20 +1002,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1022,63 +1042,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location, ctx); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, CompilationContext *ctx)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, CompilationContext *ctx)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1087,7 +1116,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1110,21 +1139,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, CompilationContext *ctx)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1132,15 +1162,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, ctx); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1161,320 +1191,214 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-#if YYERROR_VERBOSE
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
 
-  return yyd - 1;
-}
-#  endif
-# endif
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls;
+    YYLTYPE *yylsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, CompilationContext *ctx)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Location data for the lookahead symbol.  */
-YYLTYPE yylloc
+int
+yyparse (CompilationContext *ctx)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      static YYLTYPE yyloc_default
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
-/* Number of syntax errors so far.  */
-int yynerrs;
+      YYLTYPE yylloc = yyloc_default;
+      yyerror (&yylloc, ctx, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, ctx);
+  yypstate_delete (yyps);
+  return yystatus;
+}
+
+int
+yypull_parse (yypstate *yyps, CompilationContext *ctx)
+{
+  YY_ASSERT (yyps);
+  static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+  YYLTYPE yylloc = yyloc_default;
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval, &yylloc, ctx);
+    yystatus = yypush_parse (yyps, yychar, &yylval, &yylloc, ctx);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
+
+#define seal_yynerrs yyps->seal_yynerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yylsa yyps->yylsa
+#define yyls yyps->yyls
+#define yylsp yyps->yylsp
+#define yystacksize yyps->yystacksize
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
+  yyssp = yyss;
+  yyvsp = yyvs;
+  yylsp = yyls;
 
-/*----------.
-| yyparse.  |
-`----------*/
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
 
-int
-yyparse (void)
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yyls = yylsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+/*---------------.
+| yypush_parse.  |
+`---------------*/
 
-    /* The location stack.  */
-    YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, YYLTYPE *yypushed_loc, CompilationContext *ctx)
+{
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
 
-    YYSIZE_T yystacksize;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1482,43 +1406,63 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
-  yylsp[0] = yylloc;
+
+  yylsp[0] = *yypushed_loc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1526,32 +1470,29 @@ yyparse (void)
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1560,31 +1501,32 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1595,18 +1537,42 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
+      if (yypushed_loc)
+        yylloc = *yypushed_loc;
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1634,15 +1600,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1657,7 +1622,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1673,614 +1638,620 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 187 "seal.y" /* yacc.c:1646  */
-    {
+  case 2: /* program: decl_list  */
+#line 190 "seal.y"
+                                    {
 					(yyloc) = (yylsp[0]);
-					ast_root = program((yyvsp[0].decls)); 
+					ctx->root = program((yyvsp[0].decls)); 
 				}
-#line 1688 "seal.tab.c" /* yacc.c:1646  */
+#line 1654 "seal.tab.c"
     break;
 
-  case 3:
-#line 192 "seal.y" /* yacc.c:1646  */
-    {
+  case 3: /* decl: variableDecl  */
+#line 196 "seal.y"
+                                       {
 					(yyval.decl) = (yyvsp[0].variableDecl);
 				}
-#line 1696 "seal.tab.c" /* yacc.c:1646  */
+#line 1662 "seal.tab.c"
     break;
 
-  case 4:
-#line 195 "seal.y" /* yacc.c:1646  */
-    {
+  case 4: /* decl: callDecl  */
+#line 199 "seal.y"
+                                   {
 					(yyval.decl) = (yyvsp[0].callDecl);
 				}
-#line 1704 "seal.tab.c" /* yacc.c:1646  */
+#line 1670 "seal.tab.c"
     break;
 
-  case 5:
-#line 200 "seal.y" /* yacc.c:1646  */
-    { 
+  case 5: /* decl_list: decl  */
+#line 207 "seal.y"
+                               { 
 					(yyval.decls) = single_Decls((yyvsp[0].decl));
+					if (ctx->on_decl != NULL)
+						ctx->on_decl((yyvsp[0].decl), ctx->on_decl_data);
 				}
-#line 1712 "seal.tab.c" /* yacc.c:1646  */
+#line 1680 "seal.tab.c"
     break;
 
-  case 6:
-#line 203 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.decls) = append_Decls((yyvsp[-1].decls), single_Decls((yyvsp[0].decl))); 
+  case 6: /* decl_list: decl_list decl  */
+#line 212 "seal.y"
+                                         { 
+					(yyval.decls) = add_Decls((yyvsp[-1].decls), (yyvsp[0].decl)); 
+					if (ctx->on_decl != NULL)
+						ctx->on_decl((yyvsp[0].decl), ctx->on_decl_data);
 				}
-#line 1720 "seal.tab.c" /* yacc.c:1646  */
+#line 1690 "seal.tab.c"
     break;
 
-  case 7:
-#line 209 "seal.y" /* yacc.c:1646  */
-    {
+  case 7: /* variableDecl: variable ';'  */
+#line 219 "seal.y"
+                                       {
 					(yyval.variableDecl) = variableDecl((yyvsp[-1].variable));
 				}
-#line 1728 "seal.tab.c" /* yacc.c:1646  */
+#line 1698 "seal.tab.c"
     break;
 
-  case 8:
-#line 214 "seal.y" /* yacc.c:1646  */
-    { 
+  case 8: /* variableDecl_list: variableDecl  */
+#line 224 "seal.y"
+                                       { 
 					(yyval.variableDecls) = single_VariableDecls((yyvsp[0].variableDecl));
 				}
-#line 1736 "seal.tab.c" /* yacc.c:1646  */
+#line 1706 "seal.tab.c"
     break;
 
-  case 9:
-#line 217 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.variableDecls) = append_VariableDecls((yyvsp[-1].variableDecls), single_VariableDecls((yyvsp[0].variableDecl))); 
+  case 9: /* variableDecl_list: variableDecl_list variableDecl  */
+#line 227 "seal.y"
+                                                         { 
+					(yyval.variableDecls) = add_VariableDecls((yyvsp[-1].variableDecls), (yyvsp[0].variableDecl)); 
 				}
-#line 1744 "seal.tab.c" /* yacc.c:1646  */
+#line 1714 "seal.tab.c"
     break;
 
-  case 10:
-#line 222 "seal.y" /* yacc.c:1646  */
-    {
+  case 10: /* variable: TYPEID OBJECTID  */
+#line 232 "seal.y"
+                                          {
 					(yyval.variable) = variable((yyvsp[-1].symbol), (yyvsp[0].symbol));
 				}
-#line 1752 "seal.tab.c" /* yacc.c:1646  */
+#line 1722 "seal.tab.c"
     break;
 
-  case 11:
-#line 226 "seal.y" /* yacc.c:1646  */
-    { 
+  case 11: /* variable_list: variable  */
+#line 237 "seal.y"
+                                   { 
 					(yyval.variables) = single_Variables((yyvsp[0].variable));
 				}
-#line 1760 "seal.tab.c" /* yacc.c:1646  */
+#line 1730 "seal.tab.c"
     break;
 
-  case 12:
-#line 229 "seal.y" /* yacc.c:1646  */
-    {
-					(yyval.variables) = append_Variables((yyvsp[-2].variables), single_Variables((yyvsp[0].variable)));
+  case 12: /* variable_list: variable_list ',' variable  */
+#line 240 "seal.y"
+                                                     {
+					(yyval.variables) = add_Variables((yyvsp[-2].variables), (yyvsp[0].variable));
 				}
-#line 1768 "seal.tab.c" /* yacc.c:1646  */
+#line 1738 "seal.tab.c"
     break;
 
-  case 13:
-#line 235 "seal.y" /* yacc.c:1646  */
-    {
+  case 13: /* callDecl: TYPEID FUNC OBJECTID '(' variable_list ')' stmtBlock  */
+#line 245 "seal.y"
+                                                                               {
 					(yyval.callDecl) = callDecl((yyvsp[-4].symbol), (yyvsp[-2].variables), (yyvsp[-6].symbol), (yyvsp[0].stmtBlock));
 				}
-#line 1776 "seal.tab.c" /* yacc.c:1646  */
+#line 1746 "seal.tab.c"
     break;
 
-  case 14:
-#line 238 "seal.y" /* yacc.c:1646  */
-    {
+  case 14: /* callDecl: TYPEID FUNC OBJECTID '(' ')' stmtBlock  */
+#line 248 "seal.y"
+                                                                 {
 					(yyval.callDecl) = callDecl((yyvsp[-3].symbol), nil_Variables(), (yyvsp[-5].symbol), (yyvsp[0].stmtBlock));
 				}
-#line 1784 "seal.tab.c" /* yacc.c:1646  */
+#line 1754 "seal.tab.c"
     break;
 
-  case 15:
-#line 243 "seal.y" /* yacc.c:1646  */
-    {
+  case 15: /* stmtBlock: '{' variableDecl_list stmt_list '}'  */
+#line 253 "seal.y"
+                                                              {
 					(yyval.stmtBlock) = stmtBlock((yyvsp[-2].variableDecls), (yyvsp[-1].stmts));
 				}
-#line 1792 "seal.tab.c" /* yacc.c:1646  */
+#line 1762 "seal.tab.c"
     break;
 
-  case 16:
-#line 246 "seal.y" /* yacc.c:1646  */
-    {
+  case 16: /* stmtBlock: '{' stmt_list '}'  */
+#line 256 "seal.y"
+                                            {
 					(yyval.stmtBlock) = stmtBlock(nil_VariableDecls(), (yyvsp[-1].stmts));
 				}
-#line 1800 "seal.tab.c" /* yacc.c:1646  */
+#line 1770 "seal.tab.c"
     break;
 
-  case 17:
-#line 249 "seal.y" /* yacc.c:1646  */
-    {
+  case 17: /* stmtBlock: '{' variableDecl_list '}'  */
+#line 259 "seal.y"
+                                                    {
 					(yyval.stmtBlock) = stmtBlock((yyvsp[-1].variableDecls), nil_Stmts());
 				}
-#line 1808 "seal.tab.c" /* yacc.c:1646  */
+#line 1778 "seal.tab.c"
     break;
 
-  case 18:
-#line 252 "seal.y" /* yacc.c:1646  */
-    {
+  case 18: /* stmtBlock: '{' '}'  */
+#line 262 "seal.y"
+                                  {
 					(yyval.stmtBlock) = stmtBlock(nil_VariableDecls(), nil_Stmts());
 				}
-#line 1816 "seal.tab.c" /* yacc.c:1646  */
+#line 1786 "seal.tab.c"
     break;
 
-  case 19:
-#line 257 "seal.y" /* yacc.c:1646  */
-    {
+  case 19: /* stmt: ';'  */
+#line 267 "seal.y"
+                              {
 					(yyval.stmt) = no_expr();
 				}
-#line 1824 "seal.tab.c" /* yacc.c:1646  */
+#line 1794 "seal.tab.c"
     break;
 
-  case 20:
-#line 260 "seal.y" /* yacc.c:1646  */
-    {
+  case 20: /* stmt: expr ';'  */
+#line 270 "seal.y"
+                                   {
 					(yyval.stmt) = (yyvsp[-1].expr);
 				}
-#line 1832 "seal.tab.c" /* yacc.c:1646  */
+#line 1802 "seal.tab.c"
     break;
 
-  case 21:
-#line 263 "seal.y" /* yacc.c:1646  */
-    {
+  case 21: /* stmt: ifStmt  */
+#line 273 "seal.y"
+                                 {
 					(yyval.stmt) = (yyvsp[0].ifStmt);
 				}
-#line 1840 "seal.tab.c" /* yacc.c:1646  */
+#line 1810 "seal.tab.c"
     break;
 
-  case 22:
-#line 266 "seal.y" /* yacc.c:1646  */
-    {
+  case 22: /* stmt: whileStmt  */
+#line 276 "seal.y"
+                                    {
 					(yyval.stmt) = (yyvsp[0].whileStmt);
 				}
-#line 1848 "seal.tab.c" /* yacc.c:1646  */
+#line 1818 "seal.tab.c"
     break;
 
-  case 23:
-#line 269 "seal.y" /* yacc.c:1646  */
-    {
+  case 23: /* stmt: forStmt  */
+#line 279 "seal.y"
+                                  {
 					(yyval.stmt) = (yyvsp[0].forStmt);
 				}
-#line 1856 "seal.tab.c" /* yacc.c:1646  */
+#line 1826 "seal.tab.c"
     break;
 
-  case 24:
-#line 272 "seal.y" /* yacc.c:1646  */
-    {
+  case 24: /* stmt: breakStmt  */
+#line 282 "seal.y"
+                                    {
 					(yyval.stmt) = (yyvsp[0].breakStmt);
 				}
-#line 1864 "seal.tab.c" /* yacc.c:1646  */
+#line 1834 "seal.tab.c"
     break;
 
-  case 25:
-#line 275 "seal.y" /* yacc.c:1646  */
-    {
+  case 25: /* stmt: continueStmt  */
+#line 285 "seal.y"
+                                       {
 					(yyval.stmt) = (yyvsp[0].continueStmt);
 				}
-#line 1872 "seal.tab.c" /* yacc.c:1646  */
+#line 1842 "seal.tab.c"
     break;
 
-  case 26:
-#line 278 "seal.y" /* yacc.c:1646  */
-    {
+  case 26: /* stmt: returnStmt  */
+#line 288 "seal.y"
+                                     {
 					(yyval.stmt) = (yyvsp[0].returnStmt);
 				}
-#line 1880 "seal.tab.c" /* yacc.c:1646  */
+#line 1850 "seal.tab.c"
     break;
 
-  case 27:
-#line 281 "seal.y" /* yacc.c:1646  */
-    {
+  case 27: /* stmt: stmtBlock  */
+#line 291 "seal.y"
+                                    {
 					(yyval.stmt) = (yyvsp[0].stmtBlock);
 				}
-#line 1888 "seal.tab.c" /* yacc.c:1646  */
+#line 1858 "seal.tab.c"
     break;
 
-  case 28:
-#line 286 "seal.y" /* yacc.c:1646  */
-    { 
+  case 28: /* stmt_list: stmt  */
+#line 296 "seal.y"
+                               { 
 					(yyval.stmts) = single_Stmts((yyvsp[0].stmt));
 				}
-#line 1896 "seal.tab.c" /* yacc.c:1646  */
+#line 1866 "seal.tab.c"
     break;
 
-  case 29:
-#line 289 "seal.y" /* yacc.c:1646  */
-    {
-					(yyval.stmts) = append_Stmts((yyvsp[-1].stmts), single_Stmts((yyvsp[0].stmt)));
+  case 29: /* stmt_list: stmt_list stmt  */
+#line 299 "seal.y"
+                                         {
+					(yyval.stmts) = add_Stmts((yyvsp[-1].stmts), (yyvsp[0].stmt));
 				}
-#line 1904 "seal.tab.c" /* yacc.c:1646  */
+#line 1874 "seal.tab.c"
     break;
 
-  case 30:
-#line 294 "seal.y" /* yacc.c:1646  */
-    {
+  case 30: /* ifStmt: IF expr stmtBlock  */
+#line 304 "seal.y"
+                                            {
 					(yyval.ifStmt) = ifstmt((yyvsp[-1].expr), (yyvsp[0].stmtBlock), stmtBlock(nil_VariableDecls(), nil_Stmts()));
 				}
-#line 1912 "seal.tab.c" /* yacc.c:1646  */
+#line 1882 "seal.tab.c"
     break;
 
-  case 31:
-#line 297 "seal.y" /* yacc.c:1646  */
-    {
+  case 31: /* ifStmt: IF expr stmtBlock ELSE stmtBlock  */
+#line 307 "seal.y"
+                                                           {
 					(yyval.ifStmt) = ifstmt((yyvsp[-3].expr), (yyvsp[-2].stmtBlock), (yyvsp[0].stmtBlock));
 				}
-#line 1920 "seal.tab.c" /* yacc.c:1646  */
+#line 1890 "seal.tab.c"
     break;
 
-  case 32:
-#line 302 "seal.y" /* yacc.c:1646  */
-    {
+  case 32: /* whileStmt: WHILE expr stmtBlock  */
+#line 312 "seal.y"
+                                               {
 					(yyval.whileStmt) = whilestmt((yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1928 "seal.tab.c" /* yacc.c:1646  */
+#line 1898 "seal.tab.c"
     break;
 
-  case 33:
-#line 307 "seal.y" /* yacc.c:1646  */
-    {
+  case 33: /* forStmt: FOR expr ';' expr ';' expr stmtBlock  */
+#line 317 "seal.y"
+                                                               {
 					(yyval.forStmt) = forstmt((yyvsp[-5].expr), (yyvsp[-3].expr), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1936 "seal.tab.c" /* yacc.c:1646  */
+#line 1906 "seal.tab.c"
     break;
 
-  case 34:
-#line 310 "seal.y" /* yacc.c:1646  */
-    {
+  case 34: /* forStmt: FOR ';' expr ';' expr stmtBlock  */
+#line 320 "seal.y"
+                                                          {
 					(yyval.forStmt) = forstmt(no_expr(), (yyvsp[-3].expr), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1944 "seal.tab.c" /* yacc.c:1646  */
+#line 1914 "seal.tab.c"
     break;
 
-  case 35:
-#line 313 "seal.y" /* yacc.c:1646  */
-    {
+  case 35: /* forStmt: FOR expr ';' ';' expr stmtBlock  */
+#line 323 "seal.y"
+                                                          {
 					(yyval.forStmt) = forstmt((yyvsp[-4].expr), no_expr(), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1952 "seal.tab.c" /* yacc.c:1646  */
+#line 1922 "seal.tab.c"
     break;
 
-  case 36:
-#line 316 "seal.y" /* yacc.c:1646  */
-    {
+  case 36: /* forStmt: FOR expr ';' expr ';' stmtBlock  */
+#line 326 "seal.y"
+                                                          {
 					(yyval.forStmt) = forstmt((yyvsp[-4].expr), (yyvsp[-2].expr), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1960 "seal.tab.c" /* yacc.c:1646  */
+#line 1930 "seal.tab.c"
     break;
 
-  case 37:
-#line 319 "seal.y" /* yacc.c:1646  */
-    {
+  case 37: /* forStmt: FOR ';' ';' expr stmtBlock  */
+#line 329 "seal.y"
+                                                     {
 					(yyval.forStmt) = forstmt(no_expr(), no_expr(), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1968 "seal.tab.c" /* yacc.c:1646  */
+#line 1938 "seal.tab.c"
     break;
 
-  case 38:
-#line 322 "seal.y" /* yacc.c:1646  */
-    {
+  case 38: /* forStmt: FOR ';' expr ';' stmtBlock  */
+#line 332 "seal.y"
+                                                     {
 					(yyval.forStmt) = forstmt(no_expr(), (yyvsp[-2].expr), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1976 "seal.tab.c" /* yacc.c:1646  */
+#line 1946 "seal.tab.c"
     break;
 
-  case 39:
-#line 325 "seal.y" /* yacc.c:1646  */
-    {
+  case 39: /* forStmt: FOR expr ';' ';' stmtBlock  */
+#line 335 "seal.y"
+                                                     {
 					(yyval.forStmt) = forstmt((yyvsp[-3].expr), no_expr(), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1984 "seal.tab.c" /* yacc.c:1646  */
+#line 1954 "seal.tab.c"
     break;
 
-  case 40:
-#line 328 "seal.y" /* yacc.c:1646  */
-    {
+  case 40: /* forStmt: FOR ';' ';' stmtBlock  */
+#line 338 "seal.y"
+                                                {
 					(yyval.forStmt) = forstmt(no_expr(), no_expr(), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1992 "seal.tab.c" /* yacc.c:1646  */
+#line 1962 "seal.tab.c"
     break;
 
-  case 41:
-#line 333 "seal.y" /* yacc.c:1646  */
-    {
+  case 41: /* breakStmt: BREAK ';'  */
+#line 343 "seal.y"
+                                    {
 					(yyval.breakStmt) = breakstmt();
 				}
-#line 2000 "seal.tab.c" /* yacc.c:1646  */
+#line 1970 "seal.tab.c"
     break;
 
-  case 42:
-#line 338 "seal.y" /* yacc.c:1646  */
-    {
+  case 42: /* continueStmt: CONTINUE ';'  */
+#line 348 "seal.y"
+                                       {
 					(yyval.continueStmt) = continuestmt();
 				}
-#line 2008 "seal.tab.c" /* yacc.c:1646  */
+#line 1978 "seal.tab.c"
     break;
 
-  case 43:
-#line 343 "seal.y" /* yacc.c:1646  */
-    {
+  case 43: /* returnStmt: RETURN expr ';'  */
+#line 353 "seal.y"
+                                          {
 					(yyval.returnStmt) = returnstmt((yyvsp[-1].expr));
 				}
-#line 2016 "seal.tab.c" /* yacc.c:1646  */
+#line 1986 "seal.tab.c"
     break;
 
-  case 44:
-#line 346 "seal.y" /* yacc.c:1646  */
-    {
+  case 44: /* returnStmt: RETURN ';'  */
+#line 356 "seal.y"
+                                     {
 					(yyval.returnStmt) = returnstmt(no_expr());
 				}
-#line 2024 "seal.tab.c" /* yacc.c:1646  */
+#line 1994 "seal.tab.c"
     break;
 
-  case 45:
-#line 351 "seal.y" /* yacc.c:1646  */
-    {
+  case 45: /* expr: OBJECTID '=' expr  */
+#line 361 "seal.y"
+                                            {
 					(yyval.expr) = assign((yyvsp[-2].symbol), (yyvsp[0].expr));
 				}
-#line 2032 "seal.tab.c" /* yacc.c:1646  */
+#line 2002 "seal.tab.c"
     break;
 
-  case 46:
-#line 354 "seal.y" /* yacc.c:1646  */
-    {
+  case 46: /* expr: CONST_INT  */
+#line 364 "seal.y"
+                                    {
 					(yyval.expr) = const_int((yyvsp[0].symbol));
 				}
-#line 2040 "seal.tab.c" /* yacc.c:1646  */
+#line 2010 "seal.tab.c"
     break;
 
-  case 47:
-#line 357 "seal.y" /* yacc.c:1646  */
-    {
+  case 47: /* expr: CONST_STRING  */
+#line 367 "seal.y"
+                                       {
 					(yyval.expr) = const_string((yyvsp[0].symbol));
 				}
-#line 2048 "seal.tab.c" /* yacc.c:1646  */
+#line 2018 "seal.tab.c"
     break;
 
-  case 48:
-#line 360 "seal.y" /* yacc.c:1646  */
-    {
+  case 48: /* expr: CONST_FLOAT  */
+#line 370 "seal.y"
+                                      {
 					(yyval.expr) = const_float((yyvsp[0].symbol));
 				}
-#line 2056 "seal.tab.c" /* yacc.c:1646  */
+#line 2026 "seal.tab.c"
     break;
 
-  case 49:
-#line 363 "seal.y" /* yacc.c:1646  */
-    {
+  case 49: /* expr: CONST_BOOL  */
+#line 373 "seal.y"
+                                     {
 					(yyval.expr) = const_bool((yyvsp[0].boolean));
 				}
-#line 2064 "seal.tab.c" /* yacc.c:1646  */
+#line 2034 "seal.tab.c"
     break;
 
-  case 50:
-#line 366 "seal.y" /* yacc.c:1646  */
-    {
+  case 50: /* expr: OBJECTID  */
+#line 376 "seal.y"
+                                   {
 					(yyval.expr) = object((yyvsp[0].symbol));
 				}
-#line 2072 "seal.tab.c" /* yacc.c:1646  */
+#line 2042 "seal.tab.c"
     break;
 
-  case 51:
-#line 369 "seal.y" /* yacc.c:1646  */
-    {
+  case 51: /* expr: call  */
+#line 379 "seal.y"
+                               {
 					(yyval.expr) = (yyvsp[0].call);
 				}
-#line 2080 "seal.tab.c" /* yacc.c:1646  */
+#line 2050 "seal.tab.c"
     break;
 
-  case 52:
-#line 372 "seal.y" /* yacc.c:1646  */
-    {
+  case 52: /* expr: '(' expr ')'  */
+#line 382 "seal.y"
+                                       {
 					(yyval.expr) = (yyvsp[-1].expr);
 				}
-#line 2088 "seal.tab.c" /* yacc.c:1646  */
+#line 2058 "seal.tab.c"
     break;
 
-  case 53:
-#line 375 "seal.y" /* yacc.c:1646  */
-    {
+  case 53: /* expr: expr '+' expr  */
+#line 385 "seal.y"
+                                        {
 					(yyval.expr) = add((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2096 "seal.tab.c" /* yacc.c:1646  */
+#line 2066 "seal.tab.c"
     break;
 
-  case 54:
-#line 378 "seal.y" /* yacc.c:1646  */
-    {
+  case 54: /* expr: expr '-' expr  */
+#line 388 "seal.y"
+                                        {
 					(yyval.expr) = minus((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2104 "seal.tab.c" /* yacc.c:1646  */
+#line 2074 "seal.tab.c"
     break;
 
-  case 55:
-#line 381 "seal.y" /* yacc.c:1646  */
-    {
+  case 55: /* expr: expr '*' expr  */
+#line 391 "seal.y"
+                                        {
 					(yyval.expr) = multi((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2112 "seal.tab.c" /* yacc.c:1646  */
+#line 2082 "seal.tab.c"
     break;
 
-  case 56:
-#line 384 "seal.y" /* yacc.c:1646  */
-    {
+  case 56: /* expr: expr '/' expr  */
+#line 394 "seal.y"
+                                        {
 					(yyval.expr) = divide((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2120 "seal.tab.c" /* yacc.c:1646  */
+#line 2090 "seal.tab.c"
     break;
 
-  case 57:
-#line 387 "seal.y" /* yacc.c:1646  */
-    {
+  case 57: /* expr: expr '%' expr  */
+#line 397 "seal.y"
+                                        {
 					(yyval.expr) = mod((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2128 "seal.tab.c" /* yacc.c:1646  */
+#line 2098 "seal.tab.c"
     break;
 
-  case 58:
-#line 390 "seal.y" /* yacc.c:1646  */
-    {
+  case 58: /* expr: '-' expr  */
+#line 400 "seal.y"
+                                                {
 					(yyval.expr) = neg((yyvsp[0].expr));
 				}
-#line 2136 "seal.tab.c" /* yacc.c:1646  */
+#line 2106 "seal.tab.c"
     break;
 
-  case 59:
-#line 393 "seal.y" /* yacc.c:1646  */
-    {
+  case 59: /* expr: expr '<' expr  */
+#line 403 "seal.y"
+                                        {
 					(yyval.expr) = lt((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2144 "seal.tab.c" /* yacc.c:1646  */
+#line 2114 "seal.tab.c"
     break;
 
-  case 60:
-#line 396 "seal.y" /* yacc.c:1646  */
-    {
+  case 60: /* expr: expr LE expr  */
+#line 406 "seal.y"
+                                       {
 					(yyval.expr) = le((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2152 "seal.tab.c" /* yacc.c:1646  */
+#line 2122 "seal.tab.c"
     break;
 
-  case 61:
-#line 399 "seal.y" /* yacc.c:1646  */
-    {
+  case 61: /* expr: expr EQUAL expr  */
+#line 409 "seal.y"
+                                          {
 					(yyval.expr) = equ((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2160 "seal.tab.c" /* yacc.c:1646  */
+#line 2130 "seal.tab.c"
     break;
 
-  case 62:
-#line 402 "seal.y" /* yacc.c:1646  */
-    {
+  case 62: /* expr: expr NE expr  */
+#line 412 "seal.y"
+                                       {
 					(yyval.expr) = neq((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2168 "seal.tab.c" /* yacc.c:1646  */
+#line 2138 "seal.tab.c"
     break;
 
-  case 63:
-#line 405 "seal.y" /* yacc.c:1646  */
-    {
+  case 63: /* expr: expr GE expr  */
+#line 415 "seal.y"
+                                       {
 					(yyval.expr) = ge((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2176 "seal.tab.c" /* yacc.c:1646  */
+#line 2146 "seal.tab.c"
     break;
 
-  case 64:
-#line 408 "seal.y" /* yacc.c:1646  */
-    {
+  case 64: /* expr: expr '>' expr  */
+#line 418 "seal.y"
+                                        {
 					(yyval.expr) = gt((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2184 "seal.tab.c" /* yacc.c:1646  */
+#line 2154 "seal.tab.c"
     break;
 
-  case 65:
-#line 411 "seal.y" /* yacc.c:1646  */
-    {
+  case 65: /* expr: expr AND expr  */
+#line 421 "seal.y"
+                                        {
 					(yyval.expr) = and_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2192 "seal.tab.c" /* yacc.c:1646  */
+#line 2162 "seal.tab.c"
     break;
 
-  case 66:
-#line 414 "seal.y" /* yacc.c:1646  */
-    {
+  case 66: /* expr: expr OR expr  */
+#line 424 "seal.y"
+                                       {
 					(yyval.expr) = or_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2200 "seal.tab.c" /* yacc.c:1646  */
+#line 2170 "seal.tab.c"
     break;
 
-  case 67:
-#line 417 "seal.y" /* yacc.c:1646  */
-    {
+  case 67: /* expr: '!' expr  */
+#line 427 "seal.y"
+                                   {
 					(yyval.expr) = not_((yyvsp[0].expr));
 				}
-#line 2208 "seal.tab.c" /* yacc.c:1646  */
+#line 2178 "seal.tab.c"
     break;
 
-  case 68:
-#line 420 "seal.y" /* yacc.c:1646  */
-    {
+  case 68: /* expr: '~' expr  */
+#line 430 "seal.y"
+                                   {
 					(yyval.expr) = bitnot((yyvsp[0].expr));
 				}
-#line 2216 "seal.tab.c" /* yacc.c:1646  */
+#line 2186 "seal.tab.c"
     break;
 
-  case 69:
-#line 423 "seal.y" /* yacc.c:1646  */
-    {
+  case 69: /* expr: expr '&' expr  */
+#line 433 "seal.y"
+                                        {
 					(yyval.expr) = bitand_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2224 "seal.tab.c" /* yacc.c:1646  */
+#line 2194 "seal.tab.c"
     break;
 
-  case 70:
-#line 426 "seal.y" /* yacc.c:1646  */
-    {
+  case 70: /* expr: expr '|' expr  */
+#line 436 "seal.y"
+                                        {
 					(yyval.expr) = bitor_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2232 "seal.tab.c" /* yacc.c:1646  */
+#line 2202 "seal.tab.c"
     break;
 
-  case 71:
-#line 429 "seal.y" /* yacc.c:1646  */
-    {
+  case 71: /* expr: expr '^' expr  */
+#line 439 "seal.y"
+                                        {
 					(yyval.expr) = xor_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2240 "seal.tab.c" /* yacc.c:1646  */
+#line 2210 "seal.tab.c"
     break;
 
-  case 72:
-#line 434 "seal.y" /* yacc.c:1646  */
-    {
+  case 72: /* call: OBJECTID '(' actual_list ')'  */
+#line 444 "seal.y"
+                                                       {
 					(yyval.call) = call((yyvsp[-3].symbol), (yyvsp[-1].actuals));
 				}
-#line 2248 "seal.tab.c" /* yacc.c:1646  */
+#line 2218 "seal.tab.c"
     break;
 
-  case 73:
-#line 437 "seal.y" /* yacc.c:1646  */
-    {
+  case 73: /* call: OBJECTID '(' ')'  */
+#line 447 "seal.y"
+                                           {
 					(yyval.call) = call((yyvsp[-2].symbol), nil_Actuals());
 				}
-#line 2256 "seal.tab.c" /* yacc.c:1646  */
+#line 2226 "seal.tab.c"
     break;
 
-  case 74:
-#line 442 "seal.y" /* yacc.c:1646  */
-    {
+  case 74: /* actual: expr  */
+#line 452 "seal.y"
+                               {
 					(yyval.actual) = actual((yyvsp[0].expr));
 				}
-#line 2264 "seal.tab.c" /* yacc.c:1646  */
+#line 2234 "seal.tab.c"
     break;
 
-  case 75:
-#line 446 "seal.y" /* yacc.c:1646  */
-    { 
+  case 75: /* actual_list: actual  */
+#line 457 "seal.y"
+                                 { 
 					(yyval.actuals) = single_Actuals((yyvsp[0].actual));
 				}
-#line 2272 "seal.tab.c" /* yacc.c:1646  */
+#line 2242 "seal.tab.c"
     break;
 
-  case 76:
-#line 449 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.actuals) = append_Actuals((yyvsp[-2].actuals), single_Actuals((yyvsp[0].actual))); 
+  case 76: /* actual_list: actual_list ',' actual  */
+#line 460 "seal.y"
+                                                 { 
+					(yyval.actuals) = add_Actuals((yyvsp[-2].actuals), (yyvsp[0].actual)); 
 				}
-#line 2280 "seal.tab.c" /* yacc.c:1646  */
+#line 2250 "seal.tab.c"
     break;
 
 
-#line 2284 "seal.tab.c" /* yacc.c:1646  */
+#line 2254 "seal.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2294,11 +2265,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2306,14 +2276,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2324,50 +2293,15 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (&yylloc, ctx, YY_("syntax error"));
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2382,7 +2316,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval, &yylloc);
+                      yytoken, &yylval, &yylloc, ctx);
           yychar = YYEMPTY;
         }
     }
@@ -2396,14 +2330,12 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
@@ -2419,13 +2351,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2439,7 +2372,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2450,13 +2383,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2467,33 +2398,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval, &yylloc);
+                  yytoken, &yylval, &yylloc, ctx);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2502,32 +2437,78 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, ctx);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+  yyps->yynew = 2;
+  goto yypushreturn;
+
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
+
   return yyresult;
 }
-#line 454 "seal.y" /* yacc.c:1906  */
+#undef seal_yynerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yylsa
+#undef yyls
+#undef yylsp
+#undef yystacksize
+#line 466 "seal.y"
 
     
+    /* Read the next token, from the scanner or a saved token stream, and
+       remember it for error messages. */
+    static int yylex(YYSTYPE *lvalp, YYLTYPE *llocp, CompilationContext *ctx)
+    {
+      int token;
+      if (ctx->tokens != NULL)
+        token = ctx->tokens->read(lvalp, &ctx->lineno);
+      else
+        token = seal_yyscan(lvalp, ctx);
+      *llocp = ctx->lineno;       /* the line of the token */
+      ctx->token = token;
+      ctx->token_value = *lvalp;
+      return token;
+    }
+    
+    /* Push one token, read by the caller, to the parser of ctx.  Returns
+       YYPUSH_MORE while the parser wants more tokens, 0 when it has
+       accepted the program and 1 when it has given up. */
+    int seal_yypush(CompilationContext *ctx, int token, YYSTYPE *value)
+    {
+      if (ctx->pstate == NULL)
+        ctx->pstate = seal_yypstate_new();
+      YYLTYPE loc = ctx->lineno;
+      ctx->token = token;
+      ctx->token_value = *value;
+      return seal_yypush_parse(ctx->pstate, token, value, &loc, ctx);
+    }
+
+    void seal_yypush_free(CompilationContext *ctx)
+    {
+      seal_yypstate_delete(ctx->pstate);
+      ctx->pstate = NULL;
+    }
+    
     /* This function is called automatically when Bison detects a parse error. */
-    void yyerror(char *s)
+    void yyerror(YYLTYPE *llocp, CompilationContext *ctx, const char *s)
     {
-      extern int curr_lineno;
-      
-      cerr << "\"" << curr_filename << "\", line " << curr_lineno << ": " \
+      cerr << "\"" << ctx->filename << "\", line " << ctx->lineno << ": " \
       << s << " at or near ";
-      print_seal_token(yychar);
+      print_seal_token(ctx->token, ctx->token_value);
       cerr << endl;
-      omerrs++;
+      ctx->errors++;
       
-      if(omerrs>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
+      if(ctx->errors>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
     }
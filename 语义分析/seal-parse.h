@@ -97,6 +97,11 @@ typedef Stmts_class *Stmts;
    /* Put the tokens into the symbol table, so that GDB and other debuggers
       know about them.  */
    enum yytokentype {
+      // bison's own: no lookahead, end of input, error, undefined token
+     YYEMPTY = -2,
+     YYEOF = 0,
+     YYerror = 256,
+     YYUNDEF = 257,
       // condition
      IF = 258,
      ELSE = 260,
@@ -128,6 +133,7 @@ typedef Stmts_class *Stmts;
      OBJECTID = 284,
      TYPEID = 285
    };
+   typedef enum yytokentype yytoken_kind_t;
 #endif
 /* Tokens.  */
 #define IF 258
@@ -193,8 +199,6 @@ typedef union YYSTYPE
 # define YYSTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYSTYPE seal_yylval;
-
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
 typedef struct YYLTYPE
 {
@@ -208,5 +212,12 @@ typedef struct YYLTYPE
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYLTYPE seal_yylloc;
+/* The push parser (see seal_yypush in seal.y): its state, and what it
+   returns while it wants more tokens */
+typedef struct seal_yypstate seal_yypstate;
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
 #endif
@@ -0,0 +1,218 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-skip.cc
+//
+// Skips blanks and comments ahead of the flex scanner.  See seal-skip.h.
+//
+// Each search has a scalar version and, on x86, an SSE2 and an AVX2
+// version.  The vector versions load aligned blocks, so a load never
+// crosses into a page the buffer does not reach, and mask off the bytes
+// before the starting point in the first block.  A search finds the
+// first byte of interest in a block with a bit scan over the movemask of
+// byte comparisons, and counts the newlines before it with a popcount.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include "seal-skip.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_SIMD 1
+#endif
+
+//
+// The scalar searches.
+//
+static inline bool is_blank(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// the first non-blank at or after p
+static char *skip_blanks_scalar(char *p, int *lines)
+{
+    for (; is_blank(*p); p++)
+        if (*p == '\n')
+            (*lines)++;
+    return p;
+}
+
+// the first \n or NUL at or after p
+static char *find_line_end_scalar(char *p)
+{
+    while (*p != '\n' && *p != '\0')
+        p++;
+    return p;
+}
+
+// the first "*/" at or after p, or NULL if a NUL comes first
+static char *find_comment_end_scalar(char *p, int *lines)
+{
+    for (; *p != '\0'; p++) {
+        if (*p == '*' && p[1] == '/')
+            return p;
+        if (*p == '\n')
+            (*lines)++;
+    }
+    return NULL;
+}
+
+#ifdef HAVE_SIMD
+
+// the bits of a w-byte block mask for bytes before i
+static inline uint32_t below(int i)
+{
+    return (uint32_t) ((1ull << i) - 1);
+}
+
+//
+// The block searches, written once for both vector widths.  VEC is the
+// vector type, W its width in bytes; LOAD, EQ and MASK load an aligned
+// block, compare bytes for equality and collect the comparison's bits.
+// Blanks are ' ' and the bytes \t..\r, which are those whose value minus
+// \t is at most 4 (unsigned).
+//
+#define BLOCK_SEARCHES(SUFFIX, ATTR, VEC, W, LOAD, EQ, MASK, SET1, SUB, MIN, OR) \
+                                                                        \
+ATTR static char *skip_blanks_##SUFFIX(char *p, int *lines)            \
+{                                                                       \
+    int off = (uintptr_t) p & (W - 1);                                  \
+    char *q = p - off;                                                  \
+    uint32_t live = ~below(off);                                        \
+    const VEC space = SET1(' '), newline = SET1('\n');                  \
+    const VEC tab = SET1('\t'), four = SET1(4);                         \
+    for (;;) {                                                          \
+        VEC v = LOAD((const VEC *) q);                                  \
+        VEC c = SUB(v, tab);                                            \
+        uint32_t blank = MASK(OR(EQ(v, space), EQ(MIN(c, four), c)));   \
+        uint32_t nl = MASK(EQ(v, newline)) & live;                      \
+        uint32_t stop = ~blank & live;                                  \
+        if (W < 32)                                                     \
+            stop &= below(W);                                           \
+        if (stop) {                                                     \
+            int i = __builtin_ctz(stop);                                \
+            *lines += __builtin_popcount(nl & below(i));                \
+            return q + i;                                               \
+        }                                                               \
+        *lines += __builtin_popcount(nl);                               \
+        q += W;                                                         \
+        live = ~0u;                                                     \
+    }                                                                   \
+}                                                                       \
+                                                                        \
+ATTR static char *find_line_end_##SUFFIX(char *p)                       \
+{                                                                       \
+    int off = (uintptr_t) p & (W - 1);                                  \
+    char *q = p - off;                                                  \
+    uint32_t live = ~below(off);                                        \
+    const VEC newline = SET1('\n'), nul = SET1(0);                      \
+    for (;;) {                                                          \
+        VEC v = LOAD((const VEC *) q);                                  \
+        uint32_t stop = MASK(OR(EQ(v, newline), EQ(v, nul))) & live;    \
+        if (stop)                                                       \
+            return q + __builtin_ctz(stop);                             \
+        q += W;                                                         \
+        live = ~0u;                                                     \
+    }                                                                   \
+}                                                                       \
+                                                                        \
+ATTR static char *find_comment_end_##SUFFIX(char *p, int *lines)       \
+{                                                                       \
+    int off = (uintptr_t) p & (W - 1);                                  \
+    char *q = p - off;                                                  \
+    uint32_t live = ~below(off);                                        \
+    const VEC star = SET1('*'), newline = SET1('\n'), nul = SET1(0);    \
+    for (;;) {                                                          \
+        VEC v = LOAD((const VEC *) q);                                  \
+        uint32_t stars = MASK(EQ(v, star)) & live;                      \
+        uint32_t nuls = MASK(EQ(v, nul)) & live;                        \
+        uint32_t nl = MASK(EQ(v, newline)) & live;                      \
+        uint32_t stop = stars | nuls;                                   \
+        while (stop) {                                                  \
+            int i = __builtin_ctz(stop);                                \
+            if ((nuls >> i) & 1)                                        \
+                return NULL;                                            \
+            if (q[i + 1] == '/') {                                      \
+                *lines += __builtin_popcount(nl & below(i));            \
+                return q + i;                                           \
+            }                                                           \
+            stop &= stop - 1;                                           \
+        }                                                               \
+        *lines += __builtin_popcount(nl);                               \
+        q += W;                                                         \
+        live = ~0u;                                                     \
+    }                                                                   \
+}
+
+BLOCK_SEARCHES(sse2, , __m128i, 16, _mm_load_si128, _mm_cmpeq_epi8,
+               (uint32_t) _mm_movemask_epi8, _mm_set1_epi8, _mm_sub_epi8,
+               _mm_min_epu8, _mm_or_si128)
+
+BLOCK_SEARCHES(avx2, __attribute__((target("avx2"))), __m256i, 32,
+               _mm256_load_si256, _mm256_cmpeq_epi8,
+               (uint32_t) _mm256_movemask_epi8, _mm256_set1_epi8,
+               _mm256_sub_epi8, _mm256_min_epu8, _mm256_or_si256)
+
+#endif
+
+//
+// The searches in use, chosen once by what the processor supports.
+//
+struct Searches {
+    char *(*skip_blanks)(char *p, int *lines);
+    char *(*find_line_end)(char *p);
+    char *(*find_comment_end)(char *p, int *lines);
+};
+
+static Searches choose_searches()
+{
+#ifdef HAVE_SIMD
+    __builtin_cpu_init();      // we may run before its own constructor
+    if (__builtin_cpu_supports("avx2")) {
+        Searches s = { skip_blanks_avx2, find_line_end_avx2,
+                       find_comment_end_avx2 };
+        return s;
+    }
+    Searches s = { skip_blanks_sse2, find_line_end_sse2,
+                   find_comment_end_sse2 };
+    return s;
+#else
+    Searches s = { skip_blanks_scalar, find_line_end_scalar,
+                   find_comment_end_scalar };
+    return s;
+#endif
+}
+
+static const Searches searches = choose_searches();
+
+char *seal_skip_bulk(char *p, int *lines)
+{
+    for (;;) {
+        p = searches.skip_blanks(p, lines);
+        if (p[0] != '/')
+            return p;
+
+        if (p[1] == '/') {
+            char *end = searches.find_line_end(p + 2);
+            if (*end != '\n')
+                return p;       // runs past the buffer: leave it to flex
+            (*lines)++;
+            p = end + 1;
+        } else if (p[1] == '*') {
+            int n = 0;
+            char *end = searches.find_comment_end(p + 2, &n);
+            if (end == NULL)
+                return p;       // likewise
+            *lines += n;
+            p = end + 2;
+        } else
+            return p;
+    }
+}
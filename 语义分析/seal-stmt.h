@@ -5,6 +5,7 @@
 #include "tree.h"
 #include "seal-tree.handcode.h"
 #include "seal-decl.h"
+const int exprstmtvalue = 0;
 const int ifstmtvalue = 1;
 const int whilestmtvalue = 2;
 const int forstmtvalue = 3;
@@ -24,6 +25,9 @@ public:
 	tree_node *copy()		 { return copy_Program(); }
     void dump(ostream& stream, int n);
     void dump_with_types(ostream&, int);
+    void dump_with_types(DumpBuffer&,int);
+    void save(AstWriter&);
+    void code(BytecodeGen&);
 
 	void semant();
 	// for semantic analysis
@@ -33,9 +37,12 @@ public:
 class Stmt_class : public tree_node {
 public:
 	int stmttypevalue;
+	Stmt_class() { stmttypevalue = exprstmtvalue; }   // expressions keep it
 	tree_node *copy()		 { return copy_Stmt(); }
 	virtual Stmt copy_Stmt() = 0;
-	virtual void dump_with_types(ostream&,int) = 0; 
+	virtual void dump_with_types(DumpBuffer&,int) = 0; 
+	virtual void save(AstWriter&) = 0;
+	virtual void code(BytecodeGen&) = 0;
 	virtual void dump(ostream&,int) = 0;
 	virtual void check(Symbol) = 0;
 };
@@ -54,10 +61,14 @@ public:
 	Stmts getStmts(){return stmts;}
 
 	VariableDecls getVariableDecls(){return vars;};
+	// no variable declarations and no statements
+	bool is_empty(){return vars->len() == 0 && stmts->len() == 0;}
 	StmtBlock copy_StmtBlock();
 	void check(Symbol);
 	void dump(ostream& , int );
-	void dump_with_types(ostream&,int);
+	void dump_with_types(DumpBuffer&,int);
+	void save(AstWriter&);
+	void code(BytecodeGen&);
 };
 
 class IfStmt_class : public Stmt_class {
@@ -78,7 +89,9 @@ public:
     Stmt copy_Stmt();
 	void check(Symbol);
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
+	void dump_with_types(DumpBuffer&,int);
+	void save(AstWriter&);
+	void code(BytecodeGen&);
 };
 
 
@@ -99,7 +112,9 @@ public:
     Stmt copy_Stmt();
 	void check(Symbol);
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
+	void dump_with_types(DumpBuffer&,int);
+	void save(AstWriter&);
+	void code(BytecodeGen&);
 };
 
 class ForStmt_class : public Stmt_class {
@@ -121,7 +136,9 @@ public:
 	void check(Symbol);
     Stmt copy_Stmt();
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
+	void dump_with_types(DumpBuffer&,int);
+	void save(AstWriter&);
+	void code(BytecodeGen&);
 };
 
 
@@ -137,7 +154,9 @@ public:
 	Expr getValue(){return value;}
     Stmt copy_Stmt();
 	void check(Symbol);
-    void dump_with_types(ostream&,int);
+    void dump_with_types(DumpBuffer&,int);
+    void save(AstWriter&);
+    void code(BytecodeGen&);
     void dump(ostream& stream, int n);
 };
 
@@ -148,7 +167,9 @@ public:
 	}
     Stmt copy_Stmt();
 	void check(Symbol);
-    void dump_with_types(ostream&,int);
+    void dump_with_types(DumpBuffer&,int);
+    void save(AstWriter&);
+    void code(BytecodeGen&);
     void dump(ostream& stream, int n);
 };
 
@@ -160,7 +181,9 @@ public:
 	}
     Stmt copy_Stmt();
 	void check(Symbol);
-    void dump_with_types(ostream&,int);
+    void dump_with_types(DumpBuffer&,int);
+    void save(AstWriter&);
+    void code(BytecodeGen&);
     void dump(ostream& stream, int n);
 };
 
@@ -180,41 +203,49 @@ typedef Stmts_class *Stmts;
 StmtBlocks nil_StmtBlocks();
 StmtBlocks single_StmtBlocks(StmtBlock);
 StmtBlocks append_StmtBlocks(StmtBlocks,StmtBlocks);
+StmtBlocks add_StmtBlocks(StmtBlocks,StmtBlock);
 
 
 Stmts nil_Stmts();
 Stmts single_Stmts(Stmt);
 Stmts append_Stmts(Stmts,Stmts);
+Stmts add_Stmts(Stmts,Stmt);
 
 
 IfStmts nil_IfStmts();
 IfStmts single_IfStmts(IfStmt);
 IfStmts append_IfStmts(IfStmts,IfStmts);
+IfStmts add_IfStmts(IfStmts,IfStmt);
 
 
 WhileStmts nil_WhileStmts();
 WhileStmts single_WhileStmts(WhileStmt);
 WhileStmts append_WhileStmts(WhileStmts,WhileStmts);
+WhileStmts add_WhileStmts(WhileStmts,WhileStmt);
 
 
 ForStmts nil_ForStmts();
 ForStmts single_ForStmts(ForStmt);
 ForStmts append_ForStmts(ForStmts,ForStmts);
+ForStmts add_ForStmts(ForStmts,ForStmt);
 
 
 ReturnStmts nil_ReturnStmts();
 ReturnStmts single_ReturnStmts(ReturnStmt);
 ReturnStmts append_ReturnStmts(ReturnStmts,ReturnStmts);
+ReturnStmts add_ReturnStmts(ReturnStmts,ReturnStmt);
 
 
 ContinueStmts nil_ContinueStmts();
 ContinueStmts single_ContinueStmts(ContinueStmt);
 ContinueStmts append_ContinueStmts(ContinueStmts,ContinueStmts);
+ContinueStmts add_ContinueStmts(ContinueStmts,ContinueStmt);
 
 
 BreakStmts nil_BreakStmts();
 BreakStmts single_BreakStmts(BreakStmt);
 BreakStmts append_BreakStmts(BreakStmts,BreakStmts);
+BreakStmts add_BreakStmts(BreakStmts,BreakStmt);
 
 Program program(Decls);
 StmtBlock stmtBlock(VariableDecls, Stmts);
@@ -8,6 +8,11 @@
 #include "tree.h"
 #include "seal.h"
 #include "stringtab.h"
+#include "dumpbuf.h"
+
+class AstWriter;        // astcache.h
+class BytecodeGen;      // bytecode.h
+
 #define yylineno curr_lineno;
 extern int yylineno;
 
@@ -3,31 +3,153 @@
 #include "seal-decl.h"
 #include "seal-expr.h"
 #include "seal-stmt.h"
+#include "batch.h"
+#include "compilation.h"
+#include "session.h"
+#include "astcache.h"
+#include "cgen.h"
 
-extern Program ast_root;      // root of the abstract syntax tree
-FILE *fin;                    // input file
 extern int optind;  // used for option processing (man 3 getopt for more info)
-extern int seal_yyparse(void); // entry point to the AST parser
-extern int omerrs;            // syntax check errors
-char *curr_filename = "<stdin>";
+extern int semant_debug;      // -s: report string table and AST memory
 
 void handle_flags(int argc, char *argv[]);
+void print_expr_stats(ostream& s);
+void install_call(Decl decl, void *);
 
-int main(int argc, char *argv[]) {
-  fin = fopen(argv[optind], "r");
+//
+// -x: compile a checked program to bytecode and run it.
+//
+static int run(Program program) {
+  Bytecode *code = compile_bytecode(program);
+  if (code == NULL)
+    exit(1);
+  if (cgen_debug)
+    code->dump(cerr);
+  int status = run_bytecode(*code);
+  delete code;
+  return status;
+}
+
+//
+// -o: compile a checked program to bytecode, and that to x86-64.
+//
+static int native(Program program) {
+  Bytecode *code = compile_bytecode(program);
+  if (code == NULL)
+    exit(1);
+  if (code->main < 0) {
+    cerr << "Function main is not defined.\n";
+    exit(1);
+  }
+  int status = cgen_output(*code);
+  delete code;
+  return status;
+}
+
+//
+// Check one file and dump its typed AST, or with -x run it, or with -o
+// build it.  Exits on errors.
+//
+static int compile(char *filename) {
+  FILE *fin = fopen(filename, "r");
 	    if (fin == NULL) {
-		cerr << "Could not open input file " << argv[optind] << endl;
+		cerr << "Could not open input file " << filename << endl;
 		exit(1);
 	}
-  curr_lineno = 1;
-  handle_flags(argc,argv);
-  seal_yyparse();
-  if(omerrs != 0 || ast_root == NULL){
+  CompilationContext ctx(fin, filename);
+  Program ast_root;
+  unsigned long long key = 0;
+  if (ast_cache)                  // -a: an unchanged file is not compiled
+    key = ast_cache_key(fin);
+  if (key != 0) {
+    ast_root = load_ast(filename, key);
+    if (ast_root != NULL) {
+      if (semant_debug)
+        cerr << filename << ": typed AST loaded from " << filename << "ast\n";
+      fclose(fin);
+      if (run_program)
+        return run(ast_root);
+      if (out_filename != NULL)
+        return native(ast_root);
+      ast_root->dump_with_types(cout,0);
+      return 0;
+    }
+  }
+  if (stream_input) {
+    ctx.on_decl = install_call;   // install functions while reading on
+    ast_root = ctx.parse_stream();
+  } else {
+    if (!ctx.read_tokens()) {     // a token stream saved with -k
+      ctx.map_input();            // falls back to reading fin
+      if (keep_tokens && !ctx.save_tokens())
+        cerr << "Could not save the tokens of " << filename << endl;
+    }
+    ast_root = ctx.parse();
+  }
+  if(ast_root == NULL){
     cout << "syntax analyze failed. Please make sure syntax parser passed." << endl;
     exit(-1);
   }
   ast_root->semant();
+  if (key != 0 && !save_ast(ast_root, filename, key))
+    cerr << "Could not save the typed AST of " << filename << endl;
+  if (run_program) {
+    fclose(fin);
+    return run(ast_root);
+  }
+  if (out_filename != NULL) {
+    fclose(fin);
+    return native(ast_root);
+  }
   ast_root->dump_with_types(cout,0);
+  if (semant_debug) {
+    print_stringtab_stats(cerr);
+    ast_arena->print_stats(cerr);
+    print_expr_stats(cerr);
+  }
   fclose(fin);
+  return 0;
 }
 
+//
+// -e: the files are versions of one module, each an edit of the one
+// before.  Compile them in turn in one session, as an editor would after
+// each change, and write what semant writes for the last.
+//
+static int replay(int nfiles, char *files[]) {
+  SemantSession session(files[0]);
+  for (int i = 0; i < nfiles; i++) {
+    FILE *fin = fopen(files[i], "r");
+    if (fin == NULL) {
+      cerr << "Could not open input file " << files[i] << endl;
+      exit(1);
+    }
+    std::string source;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof buf, fin)) > 0)
+      source.append(buf, n);
+    fclose(fin);
+
+    session.filename = files[i];
+    session.update(source.data(), source.size());
+    if (semant_debug)
+      cerr << files[i] << ": " << session.reparsed << " parsed, "
+           << session.rechecked << " checked\n";
+  }
+  int errors = session.report(cout, cerr);
+  if (errors < 0) {
+    cout << "syntax analyze failed. Please make sure syntax parser passed." << endl;
+    exit(-1);
+  }
+  return errors > 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+  handle_flags(argc,argv);
+  if (edit_session)
+    return replay(argc - optind, argv + optind);
+  if (argc - optind > 1)
+    return compile_batch(argc - optind, argv + optind, batch_jobs, compile) ? 1 : 0;
+  return compile(argv[optind]);
+}
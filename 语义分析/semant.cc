@@ -1,23 +1,31 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <time.h>
 #include "semant.h"
 #include "utilities.h"
 #include <map>
+#include <atomic>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 extern int semant_debug;
-extern char *curr_filename;
+extern int check_jobs;        // -J: threads checking function bodies
 
-static ostream& error_stream = cerr;
-static int semant_errors = 0;
+// errors go to cerr, or to the buffer of the function a thread checks
+static thread_local ostream *error_stream = &cerr;
+static std::atomic<int> semant_errors(0);
 static Decl curr_decl = 0;
 
-typedef SymbolTable<Symbol, Symbol> ObjectEnvironment; // name, type
-ObjectEnvironment objectEnv;
-typedef std::map<Symbol, Decl_class*> variabletable; 
+// each thread checking function bodies has its own scope stack
+typedef BindingTable ObjectEnvironment;
+thread_local ObjectEnvironment objectEnv;
+// loops around the statement being checked, for break and continue
+static thread_local int loop_depth = 0;
+typedef SymbolMap<Decl> variabletable;
 variabletable variableTable;
-typedef std::map<Symbol, Decl_class*> funcTable;  
+typedef SymbolMap<Decl> funcTable;
 funcTable FuncTable;
 
 ///////////////////////////////////////////////
@@ -27,17 +35,17 @@ funcTable FuncTable;
 
 static ostream& semant_error() {
     semant_errors++;
-    return error_stream;
+    return *error_stream;
 }
 
 static ostream& semant_error(tree_node *t) {
-    error_stream << t->get_line_number() << ": ";
+    *error_stream << t->get_line_number() << ": ";
     return semant_error();
 }
 
 static ostream& internal_error(int lineno) {
-    error_stream << "FATAL:" << lineno << ": ";
-    return error_stream;
+    *error_stream << "FATAL:" << lineno << ": ";
+    return *error_stream;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -97,24 +105,36 @@ static bool sameType(Symbol name1, Symbol name2) {
     return strcmp(name1->get_string(), name2->get_string()) == 0;
 }
 
-static void install_calls(Decls decls) {
-    for (int i = decls->first(); decls->more(i); i = decls->next(i))
-    {
-        Decl curr_callDecl = decls->nth(i);
-        Symbol name = curr_callDecl->getName();
-        if(curr_callDecl->isCallDecl()){
-            if (FuncTable.find(name) != FuncTable.end()) {
-                semant_error(curr_callDecl)<<"Function "<<curr_callDecl->getName()<<"has already been defined.\n";
-            }
-            else if(curr_callDecl->getName() == print)
-                semant_error(curr_callDecl)<<"Function printf can't be defined.";
-            else 
-                FuncTable[name] = curr_callDecl;  //Decl to call_decl
+//
+// Functions are installed in the order they are declared.  With -i the
+// parser passes each declaration to install_call as soon as it has it
+// (see semant-phase.cc), so installed counts those already done, and
+// install_calls goes on from there.
+//
+static int installed = 0;
+
+void install_call(Decl curr_callDecl, void *) {
+    if (installed++ == 0)
+        initialize_constants();
+    Symbol name = curr_callDecl->getName();
+    if(curr_callDecl->isCallDecl()){
+        if (FuncTable.lookup(name) != NULL) {
+            semant_error(curr_callDecl)<<"Function "<<curr_callDecl->getName()<<"has already been defined.\n";
         }
+        else if(curr_callDecl->getName() == print)
+            semant_error(curr_callDecl)<<"Function printf can't be defined.";
+        else 
+            FuncTable.insert(name, curr_callDecl);  //Decl to call_decl
     }
 }
 
+static void install_calls(Decls decls) {
+    for (int i = installed; decls->more(i); i = decls->next(i))
+        install_call(decls->nth(i), NULL);
+}
+
 static void install_globalVars(Decls decls) {
+    int globals = 0;
     objectEnv.enterscope();
     for (int i = decls->first(); decls->more(i); i = decls->next(i))
     {
@@ -127,29 +147,88 @@ static void install_globalVars(Decls decls) {
             if (objectEnv.lookup(nameglobal)) {
                 semant_error(curr_variableDecl)<<"Variable"<<curr_variableDecl->getName()<<"has already been defined.\n";
             }
-            else 
-                objectEnv.addid(nameglobal, new Symbol(typeglobal));
+            else {
+                Binding global = { globalbinding, globals++, typeglobal };
+                objectEnv.addid(nameglobal, global);
+            }
         }
     }
     objectEnv.exitscope();
 }
 
-static void check_calls(Decls decls) {
-    for (int i = decls->first(); decls->more(i); i = decls->next(i))
-    {
-        Decl curr_variableDecl = decls->nth(i);
-        curr_variableDecl->check();
-        
+//
+// Once the headers are installed, checking a body only reads FuncTable,
+// so with -J the bodies are checked by a pool of threads, each with its
+// own objectEnv.  A thread takes the next declaration no thread has
+// taken yet and writes its errors to that declaration's buffer; the
+// buffers are written out in source order, so the output is the same
+// as when the declarations are checked one after another.
+//
+struct CheckQueue {
+    Decls decls;
+    std::atomic<int> next;              // the first declaration not taken
+    std::vector<std::ostringstream> messages;
+};
+
+static void check_queued(CheckQueue *queue) {
+    int n = queue->messages.size();
+    for (int i; (i = queue->next++) < n; ) {
+        error_stream = &queue->messages[i];
+        queue->decls->nth(i)->check();
     }
+    error_stream = &cerr;
+}
+
+static int check_threads = 0;          // for -s: how check_calls ran
+static double check_seconds = 0;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void check_calls(Decls decls) {
+    double start = now();
+    int n = decls->len();
+    int threads = check_jobs > 0 ? check_jobs : (int) std::thread::hardware_concurrency();
+    if (threads > n)
+        threads = n;
+    if (threads <= 1) {
+        for (int i = decls->first(); decls->more(i); i = decls->next(i))
+        {
+            Decl curr_variableDecl = decls->nth(i);
+            curr_variableDecl->check();
+        }
+        check_threads = 1;
+        check_seconds = now() - start;
+        return;
+    }
+
+    CheckQueue queue;
+    queue.decls = decls;
+    queue.next = 0;
+    queue.messages.resize(n);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.push_back(std::thread(check_queued, &queue));
+    check_queued(&queue);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    for (int i = 0; i < n; i++)
+        cerr << queue.messages[i].str();
+    check_threads = threads;
+    check_seconds = now() - start;
 }
 
 static void check_main() {
-    if(FuncTable.find(Main) == FuncTable.end()) {
+    Decl *found = FuncTable.lookup(Main);
+    if(found == NULL) {
         semant_error()<<"Function main is not defined.\n";
         return ;
     }
 
-    Decl curr_calldecl = FuncTable[Main];
+    Decl curr_calldecl = *found;
     if (curr_calldecl->getType() != Void ) {
         semant_error(curr_calldecl)<<"Main function should have return type Void.\n";
     }
@@ -200,9 +279,14 @@ void CallDecl_class::check() {
             semant_error(myvariable)<<"Formal parameter "<<formalname<<" multiply defined.\n";
         }
         else
-            objectEnv.addid(formalname, new Symbol(formaltype));
+        {
+            Binding parameter = { parameterbinding, a, formaltype };
+            objectEnv.addid(formalname, parameter);
+        }
     }
 
+    int localslots = 0;
+
     for(int k = myvaribledecls->first(); myvaribledecls->more(k); k = myvaribledecls->next(k)) 
     {
         VariableDecl myvaribledecl = myvaribledecls->nth(k);
@@ -216,8 +300,12 @@ void CallDecl_class::check() {
         if(objectEnv.lookup(name)) {
             semant_error(myvaribledecl)<<"Variable "<<name<<" multiply defined.\n";
         } 
-        else objectEnv.addid(name,new Symbol(type));            
+        else {
+            Binding local = { localbinding, localslots++, type };
+            objectEnv.addid(name, local);
+        }
     }
+    locals = localslots;
 
     Stmts mystmts = funcBody->getStmts();
     int returncount = 0;
@@ -278,11 +366,13 @@ void StmtBlock_class::check(Symbol type) {
                 break;
 
             case continuestmtvalue:
-                semant_error(mystmt)<<"Continue must be used in a loop sentence.\n";
+                if (loop_depth == 0)
+                    semant_error(mystmt)<<"Continue must be used in a loop sentence.\n";
                 break;
 
             case breakstmtvalue:
-                semant_error(mystmt)<<"Break must be used in a loop sentence.\n";
+                if (loop_depth == 0)
+                    semant_error(mystmt)<<"Break must be used in a loop sentence.\n";
                 break;
 
             default: mystmt->check(type);
@@ -298,7 +388,7 @@ void IfStmt_class::check(Symbol type) {
 
     this->getThen()->check(type);
 
-    if(this->getElse() != stmtBlock(nil_VariableDecls(), nil_Stmts()))
+    if(!this->getElse()->is_empty())
         this->getElse()->check(type);
 }
 
@@ -308,11 +398,12 @@ void WhileStmt_class::check(Symbol type) {
         semant_error(this)<<"If statement's condition must be Bool.\n";
     }
 
-    if(this->getBody()!=stmtBlock(nil_VariableDecls(),nil_Stmts()))
+    if(!this->getBody()->is_empty())
     {
         StmtBlock mysytmtBlock = this->getBody();
         Stmts mystmts = mysytmtBlock->getStmts();
 
+        loop_depth++;
         for(int j = mystmts->first(); mystmts->more(j); j = mystmts->next(j))
         {
             Stmt  mystmt = mystmts->nth(j);
@@ -326,6 +417,7 @@ void WhileStmt_class::check(Symbol type) {
                     break;
             }
         }
+        loop_depth--;
     }
     return ;
 }
@@ -334,20 +426,21 @@ void ForStmt_class::check(Symbol type) {
     Expr initexpr, condition, loopact;
 	StmtBlock body;
 
-    if(this->getInit()!=no_expr())
+    if(!this->getInit()->is_empty_Expr())
         this->getInit()->check(type);
 
-    if(this->getLoop()!=no_expr())
+    if(!this->getLoop()->is_empty_Expr())
         this->getLoop()->check(type);
 
-    if(this->getCondition()!=no_expr())
+    if(!this->getCondition()->is_empty_Expr())
         this->getCondition()->check(type);
 
-    if(this->getBody()!=stmtBlock(nil_VariableDecls(),nil_Stmts()))
+    if(!this->getBody()->is_empty())
     {
         StmtBlock mysytmtBlock = this->getBody();
         Stmts mystmts = mysytmtBlock->getStmts();
 
+        loop_depth++;
         for(int j=mystmts->first();mystmts->more(j);j=mystmts->next(j))
         {
             Stmt  mystmt = mystmts->nth(j);
@@ -361,6 +454,7 @@ void ForStmt_class::check(Symbol type) {
                     break;
             }  
         }   
+        loop_depth--;
     }
 }
 
@@ -380,14 +474,14 @@ void BreakStmt_class::check(Symbol type) {
 
 }
 
-Symbol Call_class::checkType(){
+Symbol Call_class::inferType(){
     Symbol funcname = this->getName();
 
     Actuals myactualparas = this->getActuals();
 
     if(funcname == print){
-        if(myactualparas != nil_Actuals()){
-            Actual firstactual = myactualparas->nth(1);
+        if(myactualparas->len() != 0){
+            Actual firstactual = myactualparas->nth(myactualparas->first());
             if(firstactual->checkType()!= String) {
                 semant_error(this)<<"The type of function printf's first parameter must be String.\n";
             }
@@ -395,10 +489,21 @@ Symbol Call_class::checkType(){
         else {
             semant_error(this)<<"Function printf must have at least one parameter.\n";
         }  
+        // the rest may be of any type
+        for(int i = myactualparas->first(); myactualparas->more(i); i = myactualparas->next(i))
+            myactualparas->nth(i)->checkType();
+        this->setType(Void);
+        return Void;
     }
 
-    Decl funcdecl = FuncTable[funcname];
-    CallDecl real_funcdecl = (CallDecl) funcdecl;
+    Decl *found = FuncTable.lookup(funcname);
+    if (found == NULL) {
+        semant_error(this)<<"Function "<<funcname<<" has not been defined.\n";
+        this->setType(Void);
+        return Void;
+    }
+    CallDecl real_funcdecl = (CallDecl) *found;
+    callee = real_funcdecl;
     Variables myformalparas = real_funcdecl->getVariables();
     std::vector<Symbol> formalparatype;
 
@@ -408,11 +513,14 @@ Symbol Call_class::checkType(){
         formalparatype.push_back(type);
     }
 
+    if (myactualparas->len() != (int) formalparatype.size())
+        semant_error(this)<<"Function "<<funcname<<" takes "<<(int) formalparatype.size()<<" parameters but provided "<<myactualparas->len()<<".\n";
+
     for(int i = myactualparas->first(); myactualparas->more(i); i = myactualparas->next(i))
     {
         Actual myactual = myactualparas->nth(i);
         Symbol actualtype = myactual->checkType();
-        if (actualtype!=formalparatype[i])
+        if (i < (int) formalparatype.size() && actualtype!=formalparatype[i])
             semant_error(this)<<"Function "<<this->getName()<<", the "<<(i+1)<<" parameter should be "<<formalparatype[i]<<" but provided a "<<actualtype<<".\n";
     }
     this->setType(real_funcdecl->getType());
@@ -420,22 +528,23 @@ Symbol Call_class::checkType(){
     return real_funcdecl->getType();
 }
 
-Symbol Actual_class::checkType(){
-    Expr type_ = this->expr;
-    this->setType(type_->checkType());
-    return  type_->checkType();
+Symbol Actual_class::inferType(){
+    return this->expr->checkType();
 }
 
-Symbol Assign_class::checkType(){
+Symbol Assign_class::inferType(){
     Symbol assignleft = this->lvalue;
     Symbol righttype = this->value->checkType();
     
-    if (objectEnv.lookup(assignleft) == NULL) {
+    Binding *found = objectEnv.lookup(assignleft);
+    
+    if (found == NULL) {
         semant_error(this)<<"Assignment to undeclared variable "<<assignleft<<".\n";
         return righttype;
     }
 
-    Symbol lefttype = *objectEnv.lookup(assignleft);
+    binding = *found;
+    Symbol lefttype = binding.type;
     
     if (!sameType(righttype, lefttype)) {
         semant_error(this)<<"Type "<<righttype<<" of the assigned expression doesn't conform to declared type "<<lefttype<<" of identifier "<<assignleft<<".\n";
@@ -446,7 +555,7 @@ Symbol Assign_class::checkType(){
     return righttype;
 }
 
-Symbol Add_class::checkType(){
+Symbol Add_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -468,7 +577,7 @@ Symbol Add_class::checkType(){
     }
 }
 
-Symbol Minus_class::checkType(){
+Symbol Minus_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -485,12 +594,12 @@ Symbol Minus_class::checkType(){
     }
 
     else{
-        this->setType(Float); 
-        return Int;           
+        this->setType(Int);
+        return Int;
     } 
 }
 
-Symbol Multi_class::checkType(){
+Symbol Multi_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -512,7 +621,7 @@ Symbol Multi_class::checkType(){
     }
 }
 
-Symbol Divide_class::checkType(){
+Symbol Divide_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -533,7 +642,7 @@ Symbol Divide_class::checkType(){
     }
 }
 
-Symbol Mod_class::checkType(){
+Symbol Mod_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();   
@@ -550,14 +659,14 @@ Symbol Mod_class::checkType(){
     }
 }
 
-Symbol Neg_class::checkType(){
+Symbol Neg_class::inferType(){
     Expr expr = this->e1;
     Symbol exprtype = expr->checkType();
 
-    if(exprtype != Int || exprtype != Float){
+    if(exprtype != Int && exprtype != Float){
         semant_error(this)<<"Only int and float can be negetive.\n";
-        return Int;
         this->setType(Int);
+        return Int;
     }
 
     else{
@@ -566,7 +675,7 @@ Symbol Neg_class::checkType(){
     }
 }
 
-Symbol Lt_class::checkType(){
+Symbol Lt_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -583,7 +692,7 @@ Symbol Lt_class::checkType(){
     }
 }
 
-Symbol Le_class::checkType(){
+Symbol Le_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -599,7 +708,7 @@ Symbol Le_class::checkType(){
     }
 }
 
-Symbol Equ_class::checkType(){
+Symbol Equ_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType(); 
@@ -623,7 +732,7 @@ Symbol Equ_class::checkType(){
     return Bool;
 }
 
-Symbol Neq_class::checkType(){
+Symbol Neq_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType(); 
@@ -647,7 +756,7 @@ Symbol Neq_class::checkType(){
     return Bool;
 }
 
-Symbol Ge_class::checkType(){
+Symbol Ge_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -663,7 +772,7 @@ Symbol Ge_class::checkType(){
     return Bool;
 }
 
-Symbol Gt_class::checkType(){
+Symbol Gt_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -679,7 +788,7 @@ Symbol Gt_class::checkType(){
     return Bool;
 }
 
-Symbol And_class::checkType(){
+Symbol And_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -693,7 +802,7 @@ Symbol And_class::checkType(){
     return Bool;
 }
 
-Symbol Or_class::checkType(){
+Symbol Or_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -707,7 +816,7 @@ Symbol Or_class::checkType(){
     return Bool;
 }
 
-Symbol Xor_class::checkType(){
+Symbol Xor_class::inferType(){
 Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -721,7 +830,7 @@ Expr expr1 = this->e1, expr2 = this->e2;
     return Bool;
 }
 
-Symbol Not_class::checkType(){
+Symbol Not_class::inferType(){
     Expr expr1 = this->e1;
 
     if(expr1->checkType() != Bool){
@@ -733,7 +842,7 @@ Symbol Not_class::checkType(){
     return Bool;
 }
 
-Symbol Bitand_class::checkType(){
+Symbol Bitand_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -746,7 +855,7 @@ Symbol Bitand_class::checkType(){
     return Int; 
 }
 
-Symbol Bitor_class::checkType(){
+Symbol Bitor_class::inferType(){
     Expr expr1 = this->e1, expr2 = this->e2;
     Symbol expr1type = expr1->checkType();
     Symbol expr2type = expr2->checkType();
@@ -759,7 +868,7 @@ Symbol Bitor_class::checkType(){
     return Int;
 }
 
-Symbol Bitnot_class::checkType(){
+Symbol Bitnot_class::inferType(){
     Expr expr1 = this->e1;
 
     if(expr1->checkType() != Int) {
@@ -771,32 +880,34 @@ Symbol Bitnot_class::checkType(){
     return Int;
 }
 
-Symbol Const_int_class::checkType(){
+Symbol Const_int_class::inferType(){
     setType(Int);
     return type;
 }
 
-Symbol Const_string_class::checkType(){
+Symbol Const_string_class::inferType(){
     setType(String);
     return type;
 }
 
-Symbol Const_float_class::checkType(){
+Symbol Const_float_class::inferType(){
     setType(Float);
     return type;
 }
 
-Symbol Const_bool_class::checkType(){
+Symbol Const_bool_class::inferType(){
     setType(Bool);
     return type;
 }
 
-Symbol Object_class::checkType(){
+Symbol Object_class::inferType(){
     Symbol name = this->var;
+    Binding *found = objectEnv.lookup(name);
     Symbol mytype;
 
-    if (objectEnv.lookup(name)){
-        mytype = *objectEnv.lookup(name);
+    if (found){
+        binding = *found;
+        mytype = binding.type;
     } 
     else{
         semant_error(this)<<"Object "<<name<<" has not been defined.\n";
@@ -807,11 +918,74 @@ Symbol Object_class::checkType(){
     return mytype;
 }
 
-Symbol No_expr_class::checkType(){
+Symbol No_expr_class::inferType(){
     setType(Void);
     return getType();
 }
 
+//
+// -s: how many times the expressions were checked.  inferType runs once
+// per node; every further checkType call is answered from the cache.
+//
+void print_expr_stats(ostream& s) {
+    int exprs = 0, visits = 0, most = 0;
+
+    for (int i = 0; i < ast_arena->node_count(); i++) {
+        Expr e = dynamic_cast<Expr>(ast_arena->nth_node(i));
+        if (e == NULL || e->visits == 0)
+            continue;
+        exprs++;
+        visits += e->visits;
+        if (e->visits > most)
+            most = e->visits;
+    }
+    s << "expressions (" << exprs << " typed)\n"
+      << "  " << visits << " visits, at most " << most << " per node\n"
+      << "  bodies checked in " << check_seconds << " s on "
+      << check_threads << " thread(s)\n";
+}
+
+//
+// semant()'s passes one at a time, for a SemantSession (see session.h):
+// it runs the passes over the declarations' headers again after every
+// edit, but checks only the bodies that may have changed.  Both return
+// the number of errors found.
+//
+int semant_headers(Decls decls) {
+    int before = semant_errors;
+    installed = 0;
+    FuncTable.clear();
+    initialize_constants();
+    install_calls(decls);
+    check_main();
+    install_globalVars(decls);
+    return semant_errors - before;
+}
+
+int semant_check(Decl decl) {
+    int before = semant_errors;
+    decl->check();
+    return semant_errors - before;
+}
+
+//
+// What checking a call to name depends on: the return and parameter
+// types of the function, or "" if there is none.
+//
+std::string semant_signature(Symbol name) {
+    Decl *found = FuncTable.lookup(name);
+    if (found == NULL)
+        return "";
+    CallDecl calldecl = (CallDecl) *found;
+    std::string signature = calldecl->getType()->get_string();
+    Variables paras = calldecl->getVariables();
+    for (int i = paras->first(); paras->more(i); i = paras->next(i)) {
+        signature += ' ';
+        signature += paras->nth(i)->getType()->get_string();
+    }
+    return signature;
+}
+
 void Program_class::semant() {
     initialize_constants();
     install_calls(decls);
@@ -12,8 +12,10 @@
 #include "seal-expr.h"
 #include "stringtab.h"
 #include "symtab.h"
+#include "symmap.h"
 #include "list.h"
 #include <stack>
+#include <string>
 
 #define TRUE 1
 #define FALSE 0
@@ -21,6 +23,11 @@
 
 // color
 
+// semant()'s passes one at a time, for a SemantSession
+int semant_headers(Decls decls);
+int semant_check(Decl decl);
+std::string semant_signature(Symbol name);
+
 
 #endif
 
@@ -0,0 +1,386 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: session.cc
+//
+// Compiling one module again and again as it is edited.  See session.h.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include "session.h"
+#include "compilation.h"
+
+SemantSession::SemantSession(char *filename_)
+    : text(2, '\0'), arena(new AstArena()), module(NULL), live_nodes(0),
+      header_errors(0), parsed(false), filename(filename_), reparsed(0),
+      rechecked(0)
+{
+}
+
+SemantSession::~SemantSession()
+{
+    for (size_t i = 0; i < segments.size(); i++)
+        delete segments[i];
+    delete arena;
+}
+
+// forget everything, and free the ASTs
+void SemantSession::clear()
+{
+    for (size_t i = 0; i < segments.size(); i++)
+        delete segments[i];
+    segments.clear();
+    signatures.clear();
+    delete arena;
+    arena = new AstArena();
+    live_nodes = 0;
+    text.assign(2, '\0');
+}
+
+//
+// update() keeps what parsing writes to cerr for report().  The lexer and
+// the parser still exit on some errors, as semant does; what they wrote
+// before is then written out after all.
+//
+static std::ostringstream *parse_errors;
+static std::streambuf *parse_errors_saved;
+
+static void write_parse_errors()
+{
+    if (parse_errors == NULL)
+        return;
+    cerr.rdbuf(parse_errors_saved);
+    cerr << parse_errors->str();
+}
+
+static void capture_parse_errors(std::ostringstream *errors)
+{
+    static bool registered = atexit(write_parse_errors) == 0;
+    (void) registered;
+    parse_errors = errors;
+    parse_errors_saved = cerr.rdbuf(errors->rdbuf());
+}
+
+static void release_parse_errors()
+{
+    cerr.rdbuf(parse_errors_saved);
+    parse_errors = NULL;
+}
+
+static void take_decl(Decl decl, void *data)
+{
+    *(Decl *) data = decl;
+}
+
+//
+// Parse the segment from source, the whole of the new text, into the
+// session's arena, and note the functions its body calls.
+//
+bool SemantSession::parse(Segment *s, const std::string &source)
+{
+    std::string buf(source, s->begin, s->end - s->begin);
+    buf.append(2, '\0');
+
+    int first = arena->node_count();
+    CompilationContext ctx(NULL, filename, arena);
+    ctx.scan_buffer(&buf[0], buf.size());
+    ctx.lineno = s->line;
+    ctx.on_decl = take_decl;
+    ctx.on_decl_data = &s->decl;
+    s->root = ctx.parse();
+    if (s->root == NULL)
+        return false;
+
+    s->first_node = first;
+    s->end_node = arena->node_count();
+    s->calls.clear();
+    for (int i = s->first_node; i < s->end_node; i++) {
+        Call call = dynamic_cast<Call>(arena->nth_node(i));
+        if (call != NULL)
+            s->calls.push_back(call->getName());
+    }
+    std::sort(s->calls.begin(), s->calls.end());
+    s->calls.erase(std::unique(s->calls.begin(), s->calls.end()), s->calls.end());
+    for (size_t i = 0; i < s->calls.size(); i++)
+        signatures.insert(std::make_pair(s->calls[i], std::string("?")));
+    s->checked = false;
+    live_nodes += s->end_node - s->first_node;
+    reparsed++;
+    return true;
+}
+
+// the segment has moved by bytes and lines
+void SemantSession::shift(Segment *s, long bytes, int lines)
+{
+    s->begin += bytes;
+    s->end += bytes;
+    if (lines == 0)
+        return;
+    s->line += lines;
+    s->end_line += lines;
+    for (int i = s->first_node; i < s->end_node; i++)
+        arena->nth_node(i)->shift_line_number(lines);
+}
+
+// check the segment's body, keeping the messages instead of writing them
+void SemantSession::check(Segment *s)
+{
+    std::ostringstream messages;
+    std::streambuf *saved = cerr.rdbuf(messages.rdbuf());
+    s->errors = semant_check(s->decl);
+    cerr.rdbuf(saved);
+    s->messages = messages.str();
+    s->message_line = s->line;
+    s->checked = true;
+    rechecked++;
+}
+
+//
+// Cut source, from from on, into segments, appending them to cuts.  line
+// is the line at from.  The cut stops at the end of the source, or where
+// a segment ends at the same place as an old one does in the text that
+// follows the edit, which is unchanged: the old segment's index is then
+// left in resync, which is -1 otherwise.  unchanged is where that text
+// starts.
+//
+void SemantSession::cut(const std::string &source, size_t from, int line,
+                        size_t unchanged, std::vector<Segment *> &cuts,
+                        long &resync)
+{
+    size_t n = source.size() - 2;
+    long bytes = (long) n - (long) (text.size() - 2);
+    CompilationContext ctx(NULL, filename);
+    ctx.scan_buffer((char *) &source[from], n - from + 2);
+    ctx.lineno = line;
+    ctx.cutting = true;
+
+    YYSTYPE value;
+    int tok, depth = 0;
+    size_t begin = from;
+    bool pending = false;       // tokens since the end of the last cut
+    resync = -1;
+    while ((tok = seal_yyscan(&value, &ctx)) != 0) {
+        pending = true;
+        if (tok == '{') {
+            depth++;
+            continue;
+        }
+        if (tok == '}') {
+            if (--depth > 0)
+                continue;
+        } else if (tok != ';' || depth > 0)
+            continue;
+
+        Segment *s = new Segment();
+        s->begin = begin;
+        s->end = n - seal_yyscan_unread();
+        s->line = line;
+        s->end_line = line = ctx.lineno;
+        cuts.push_back(s);
+        begin = s->end;
+        depth = 0;
+        pending = false;
+
+        if (s->end >= unchanged) {
+            size_t old_end = s->end - bytes;
+            size_t j = 0, k = segments.size();
+            while (j < k) {                     // the first ending there or later
+                size_t m = (j + k) / 2;
+                if (segments[m]->end < old_end)
+                    j = m + 1;
+                else
+                    k = m;
+            }
+            if (j < segments.size() && segments[j]->end == old_end) {
+                resync = j;
+                break;
+            }
+        }
+    }
+    seal_yyscan_reset();
+
+    // what is left cannot be a whole declaration, or did not scan; let
+    // the parser say so
+    if (pending || ctx.errors != 0 || (cuts.empty() && segments.empty())) {
+        Segment *s = new Segment();
+        s->begin = begin;
+        s->end = n;
+        s->line = line;
+        s->end_line = ctx.lineno;
+        cuts.push_back(s);
+    }
+}
+
+bool SemantSession::update(const char *source_, size_t n)
+{
+    reparsed = rechecked = 0;
+    if (arena->node_count() - live_nodes > live_nodes)
+        clear();
+
+    std::string source(source_, n);
+    source.append(2, '\0');
+    size_t old_n = text.size() - 2;
+    long bytes = (long) n - (long) old_n;
+
+    // the bytes before and after the edit
+    size_t limit = std::min(n, old_n), prefix = 0, suffix = 0;
+    while (prefix < limit && source[prefix] == text[prefix])
+        prefix++;
+    while (suffix < limit - prefix &&
+           source[n - 1 - suffix] == text[old_n - 1 - suffix])
+        suffix++;
+
+    // the segments before the first one the edit reaches stay
+    size_t first = 0;
+    while (first < segments.size() && segments[first]->end <= prefix)
+        first++;
+    size_t from = first > 0 ? segments[first - 1]->end : 0;
+    int line = first > 0 ? segments[first - 1]->end_line : 1;
+
+    // cut and parse the new segments, keeping the syntax errors for report()
+    std::vector<Segment *> cuts;
+    long resync;
+    std::ostringstream errors;
+    capture_parse_errors(&errors);
+    cut(source, from, line, n - suffix, cuts, resync);
+    size_t parsed_cuts = 0;
+    while (parsed_cuts < cuts.size() && parse(cuts[parsed_cuts], source))
+        parsed_cuts++;
+    release_parse_errors();
+    parse_messages = errors.str();
+    parsed = parsed_cuts == cuts.size();
+
+    if (!parsed) {
+        for (size_t j = 0; j < cuts.size(); j++) {
+            if (j < parsed_cuts)
+                live_nodes -= cuts[j]->end_node - cuts[j]->first_node;
+            delete cuts[j];
+        }
+        return false;
+    }
+
+    // the old segments after the resync point stay, moved
+    size_t kept = resync >= 0 ? resync + 1 : segments.size();
+    int lines = 0;
+    if (resync >= 0)
+        lines = cuts.back()->end_line - segments[resync]->end_line;
+    for (size_t i = first; i < kept; i++) {
+        live_nodes -= segments[i]->end_node - segments[i]->first_node;
+        delete segments[i];
+    }
+    for (size_t i = kept; i < segments.size(); i++)
+        shift(segments[i], bytes, lines);
+    segments.erase(segments.begin() + first, segments.begin() + kept);
+    segments.insert(segments.begin() + first, cuts.begin(), cuts.end());
+    text.swap(source);
+
+    // the headers' passes, in full
+    AstArena *outer = ast_arena;
+    ast_arena = arena;
+    headers();
+
+    // and the bodies that are new or call a function that changed.  A body
+    // checked before is parsed again, as its AST holds the old types; the
+    // module and the headers' passes must then see its new declaration.
+    std::set<Symbol> changed;
+    for (std::map<Symbol, std::string>::iterator f = signatures.begin();
+         f != signatures.end(); ++f) {
+        std::string signature = semant_signature(f->first);
+        if (signature != f->second) {
+            changed.insert(f->first);
+            f->second = signature;
+        }
+    }
+    std::vector<Segment *> stale;
+    bool replaced = false;
+    for (size_t i = 0; i < segments.size(); i++) {
+        Segment *s = segments[i];
+        bool calls_changed = false;
+        for (size_t j = 0; j < s->calls.size() && !calls_changed; j++)
+            calls_changed = changed.count(s->calls[j]) > 0;
+        if (s->checked && !calls_changed)
+            continue;
+        if (s->checked) {
+            live_nodes -= s->end_node - s->first_node;
+            parse(s, text);
+            replaced = true;
+        }
+        stale.push_back(s);
+    }
+    if (replaced)
+        headers();
+    for (size_t i = 0; i < stale.size(); i++)
+        check(stale[i]);
+    ast_arena = outer;
+    return true;
+}
+
+// build the module from the segments' declarations, and run the headers'
+// passes over it
+void SemantSession::headers()
+{
+    Decls decls = nil_Decls();
+    for (size_t i = 0; i < segments.size(); i++)
+        decls = add_Decls(decls, segments[i]->decl);
+    module = program(decls);
+    module->set(segments[0]->root);
+
+    std::ostringstream messages;
+    std::streambuf *saved = cerr.rdbuf(messages.rdbuf());
+    header_errors = semant_headers(decls);
+    cerr.rdbuf(saved);
+    header_messages = messages.str();
+}
+
+//
+// The messages were written when the segment started on message_line;
+// each begins with the line of its node, which has moved with it since.
+//
+static void write_messages(ostream &err, const std::string &messages, int lines)
+{
+    size_t at = 0;
+    while (at < messages.size()) {
+        size_t end = messages.find('\n', at);
+        end = end == std::string::npos ? messages.size() : end + 1;
+        char *rest;
+        long line = strtol(messages.c_str() + at, &rest, 10);
+        if (lines != 0 && rest != messages.c_str() + at && rest[0] == ':')
+            err << line + lines << std::string(rest, messages.c_str() + end - rest);
+        else
+            err << messages.substr(at, end - at);
+        at = end;
+    }
+}
+
+int SemantSession::report(ostream &out, ostream &err)
+{
+    if (!parsed) {
+        err << parse_messages;
+        return -1;
+    }
+
+    int errors = header_errors;
+    for (size_t i = 0; i < segments.size(); i++)
+        errors += segments[i]->errors;
+
+    if (errors == 0) {
+        module->dump_with_types(out, 0);
+        return 0;
+    }
+    err << header_messages;
+    for (size_t i = 0; i < segments.size(); i++) {
+        Segment *s = segments[i];
+        write_messages(err, s->messages, s->line - s->message_line);
+    }
+    err << "Compilation halted due to static semantic errors." << endl;
+    return errors;
+}
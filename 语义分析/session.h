@@ -0,0 +1,104 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SESSION_H_
+#define _SESSION_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: session.h
+//
+// Compiling one module again and again as it is edited.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <string>
+#include <vector>
+#include "semant.h"
+
+//
+// SemantSession
+//
+//   A session holds the source of one module, its AST and what semant
+//   found in it, and brings them up to date with each new version of the
+//   source: update(text, n) compiles the new text and returns false if it
+//   does not parse, in which case the session stays at the last version
+//   that did.  report() then writes what semant would write for the new
+//   text: its syntax errors to err, returning -1, if it did not parse, and
+//   otherwise the typed AST to out or the errors to err, returning the
+//   number of errors.  What parsing an earlier version wrote is dropped.
+//
+//   The source is cut into segments, one for each top-level declaration:
+//   from the end of the previous one to the ; or } that ends it.  The
+//   segments the edit is in are scanned and cut anew, until the cut meets
+//   the end of an old segment in the text after the edit; the segments
+//   before and after that keep their ASTs, moved by the lines the edit
+//   added or removed, and only the new ones are parsed.
+//
+//   The passes over the declarations' headers, which build the function
+//   table and the global scope, are cheap and are run again in full.
+//   Function bodies are checked only if they are new, or if they call a
+//   function whose return or parameter types have changed; those are
+//   parsed again first, as checking caches types in the AST, and the
+//   headers' passes then run again over the new declarations.  The errors
+//   checking a body found are kept with its segment.
+//
+//   Replaced ASTs stay in the session's arena until it holds more dead
+//   nodes than live ones; then the next update starts over from nothing.
+//
+//   reparsed and rechecked count the segments the last update parsed and
+//   the bodies it checked.
+//
+class SemantSession {
+private:
+    struct Segment {
+        size_t begin, end;          // its bytes of the source
+        int line, end_line;         // the lines it starts and ends on
+        Program root;               // the AST of the segment alone
+        Decl decl;                  // its one declaration
+        int first_node, end_node;   // the arena nodes of its AST
+        std::vector<Symbol> calls;  // the functions its body calls
+        bool checked;               // has its body been checked?
+        int errors;                 // the errors checking it found
+        std::string messages;       // and their messages,
+        int message_line;           // written when it started on this line
+    };
+
+    std::string text;               // the source, ending in two NULs
+    std::vector<Segment *> segments;
+    std::map<Symbol, std::string> signatures;   // of each function called
+    AstArena *arena;
+    Program module;                 // all the segments' declarations
+    int live_nodes;                 // nodes of the segments' ASTs
+    int header_errors;              // what the headers' passes found
+    std::string header_messages;
+    bool parsed;                    // did the last update parse?
+    std::string parse_messages;     // what parsing it wrote
+
+    SemantSession(const SemantSession &);        // not copyable
+    SemantSession &operator =(const SemantSession &);
+
+    void cut(const std::string &source, size_t from, int line,
+             size_t unchanged, std::vector<Segment *> &cuts, long &resync);
+    bool parse(Segment *s, const std::string &source);
+    void shift(Segment *s, long bytes, int lines);
+    void check(Segment *s);
+    void headers();
+    void clear();
+public:
+    char *filename;                 // for error messages
+    int reparsed, rechecked;
+
+    SemantSession(char *filename);
+    ~SemantSession();
+    bool update(const char *text, size_t n);
+    int report(ostream &out, ostream &err);
+};
+
+extern int edit_session;     // -e: replay the inputs as edits in a session
+
+#endif
@@ -5,6 +5,8 @@
 #include "copyright.h"
 
 #include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include "stringtab_functions.h"
 #include "stringtab.h"
 
@@ -19,10 +21,96 @@ template class StringTable<StringEntry>;
 template class StringTable<IntEntry>;
 template class StringTable<FloatEntry>;
 
-Entry::Entry(char *s, int l, int i) : len(l), index(i) {
-  str = new char [len+1];
-  strncpy(str, s, len);
+//
+// String arenas grow by chunks of at least ARENA_CHUNK bytes.  A request
+// that does not fit in the rest of the current chunk retires it; the
+// unused tail is counted as wasted.
+//
+#define ARENA_CHUNK (64 * 1024)
+
+StringArena::StringArena()
+  : chunks(NULL), next(NULL), limit(NULL), reserved(0), used(0), wasted(0) { }
+
+StringArena::~StringArena()
+{
+  while (chunks) {
+    Chunk *c = chunks;
+    chunks = c->next;
+    free(c);
+  }
+}
+
+void StringArena::new_chunk(size_t size)
+{
+  if (size < ARENA_CHUNK)
+    size = ARENA_CHUNK;
+  Chunk *c = (Chunk *) malloc(sizeof(Chunk) + size);
+  if (c == NULL) {
+    cerr << "out of memory in string table\n";
+    exit(1);
+  }
+  wasted += limit - next;
+  reserved += sizeof(Chunk) + size;
+  c->next = chunks;
+  chunks = c;
+  next = (char *) (c + 1);
+  limit = next + size;
+}
+
+void *StringArena::allocate(size_t size, size_t align)
+{
+  size_t pad = -(uintptr_t) next & (align - 1);
+  if (next == NULL || pad + size > (size_t) (limit - next)) {
+    new_chunk(size + align);
+    pad = -(uintptr_t) next & (align - 1);
+  }
+  char *p = next + pad;
+  next = p + size;
+  used += size;
+  wasted += pad;
+  return p;
+}
+
+char *StringArena::copy_string(const char *s, int len)
+{
+  char *str = (char *) allocate(len + 1, 1);
+  memcpy(str, s, len);
   str[len] = '\0';
+  return str;
+}
+
+double StringArena::fragmentation() const
+{
+  if (reserved == 0)
+    return 0;
+  return 100.0 * wasted / reserved;
+}
+
+void StringArena::print_stats(ostream& s, const char *name) const
+{
+  int n = 0;
+  for (Chunk *c = chunks; c; c = c->next)
+    n++;
+  s << name << ": " << n << " chunks, " << reserved << " bytes reserved, "
+    << used << " used, " << wasted << " wasted, " << (limit - next)
+    << " free (" << fragmentation() << "% fragmentation)\n";
+}
+
+Entry::Entry(char *s, int l, int i) : str(s), len(l), index(i) {
+  hash = hash_string(str, len);
+}
+
+//
+// FNV-1a over the characters of the string.
+//
+unsigned Entry::hash_string(const char *s, int len)
+{
+  unsigned h = 2166136261u;
+  for (int i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+  return h;
 }
 
 int Entry::equal_string(char *string, int length) const
@@ -79,4 +167,12 @@ FloatEntry::FloatEntry(char *s, int l, int i) : Entry(s,l,i) { }
 IdTable idtable;
 IntTable inttable;
 StrTable stringtable;
-FloatTable floattable;
\ No newline at end of file
+FloatTable floattable;
+
+void print_stringtab_stats(ostream& s)
+{
+  idtable.print_stats(s, "idtable");
+  inttable.print_stats(s, "inttable");
+  stringtable.print_stats(s, "stringtable");
+  floattable.print_stats(s, "floattable");
+}
\ No newline at end of file
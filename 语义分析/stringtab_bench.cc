@@ -0,0 +1,113 @@
+//
+// stringtab_bench.cc
+//
+// Interns a stream of identifiers the way the lexer does and times the
+// hash-indexed StringTable against the list-based table it replaced.
+//
+//    % make stringtab_bench
+//    % ./stringtab_bench [interns [distinct]]
+//
+// "interns" add_string calls are made with names drawn from "distinct"
+// different identifiers.  The list table is quadratic, so both tables are
+// then compared on a twentieth of the calls over a hundredth of the names.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "stringtab_functions.h"
+#include "stringtab.h"
+
+// stringtab.o's dump_Symbol needs pad(); the benchmark does not link
+// utilities.o and never dumps.
+char *pad(int n) { return (char *) ""; }
+
+//
+// The list-based table: a new Entry, with its own heap copy of the
+// string, is pushed on the front of the list, and every add_string scans
+// the list with equal_string.
+//
+class ListIdTable {
+   List<IdEntry> *tbl;
+   int index;
+public:
+   ListIdTable(): tbl((List<IdEntry> *) NULL), index(0) { }
+   IdEntry *add_string(char *s)
+   {
+      int len = strlen(s);
+      for(List<IdEntry> *l = tbl; l; l = l->tl())
+         if (l->hd()->equal_string(s,len))
+            return l->hd();
+      char *str = new char [len+1];
+      strncpy(str, s, len);
+      str[len] = '\0';
+      IdEntry *e = new IdEntry(str,len,index++);
+      tbl = new List<IdEntry>(e, tbl);
+      return e;
+   }
+   int size() { return index; }
+};
+
+static double now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//
+// Build "interns" names drawn from "distinct" identifiers, in the shape
+// of generated code: a lower-case prefix and a counter.
+//
+static char **make_names(int interns, int distinct)
+{
+   char **names = new char *[interns];
+   unsigned seed = 12345;
+   for (int i = 0; i < interns; i++) {
+      seed = seed * 1103515245 + 12345;
+      char buf[32];
+      snprintf(buf, sizeof buf, "var_%d", (int) ((seed >> 8) % distinct));
+      names[i] = strdup(buf);
+   }
+   return names;
+}
+
+template <class Table>
+static void run(const char *what, Table &t, char **names, int interns)
+{
+   double start = now();
+   for (int i = 0; i < interns; i++)
+      t.add_string(names[i]);
+   double secs = now() - start;
+   printf("%-12s %9d interns %8d entries %9.3f s %9.1f ns/intern\n",
+          what, interns, t.size(), secs, secs * 1e9 / interns);
+}
+
+class BenchIdTable : public IdTable {
+public:
+   int size() { return index; }
+};
+
+int main(int argc, char *argv[])
+{
+   int interns = argc > 1 ? atoi(argv[1]) : 4000000;
+   int distinct = argc > 2 ? atoi(argv[2]) : 1000000;
+
+   char **names = make_names(interns, distinct);
+   BenchIdTable hashed;
+   run("hash", hashed, names, interns);
+
+   char **list_names = make_names(interns / 20, distinct / 100);
+   BenchIdTable hashed_small;
+   run("hash", hashed_small, list_names, interns / 20);
+   ListIdTable listed;
+   run("list", listed, list_names, interns / 20);
+
+   hashed.print_stats(cout, "hash arena");
+
+   if (hashed_small.size() != listed.size()) {
+      cerr << "tables disagree on the number of distinct names\n";
+      return 1;
+   }
+   return 0;
+}
@@ -5,15 +5,17 @@
 #include "copyright.h"
 
 #include "seal-io.h"
-#define MAXSIZE 1000000
-#define min(a,b) (a > b ? b : a)
-
 #include "stringtab.h"
 #include <stdio.h>
+#include <new>
+
+#define MAXSIZE 1000000
+#define min(a,b) (a > b ? b : a)
 
 //
-// A string table is implemented a linked list of Entrys.  Each Entry
-// in the list has a unique string.
+// A string table is implemented as a vector of Entrys, indexed by the
+// Entry's index, plus an open-addressed hash table over the same Entrys
+// keyed on the string.  Each Entry in the table has a unique string.
 //
 
 template <class Elem>
@@ -23,52 +25,96 @@ Elem *StringTable<Elem>::add_string(char *s)
 }
 
 //
-// Add a string requires two steps.  First, the list is searched; if the
-// string is found, a pointer to the existing Entry for that string is 
-// returned.  If the string is not found, a new Entry is created and added
-// to the list.
+// Find the bucket for a string.  Buckets are probed linearly from the
+// string's hash; the cached hash in each Entry is compared before the
+// characters are.  Returns the bucket holding the matching Entry, or the
+// first empty bucket on the probe sequence if there is none.
+//
+template <class Elem>
+int StringTable<Elem>::find_bucket(char *s, int len, unsigned hash)
+{
+  int mask = buckets.size() - 1;
+  int b = hash & mask;
+  while (buckets[b] != NULL) {
+    if (buckets[b]->get_hash() == hash && buckets[b]->equal_string(s,len))
+      return b;
+    b = (b + 1) & mask;
+  }
+  return b;
+}
+
+//
+// Double the number of buckets and rehash every Entry.  The table is kept
+// at most half full so probe sequences stay short.
+//
+template <class Elem>
+void StringTable<Elem>::grow()
+{
+  int size = buckets.empty() ? 64 : 2 * buckets.size();
+  buckets.assign(size, (Elem *) NULL);
+  for (int i = 0; i < index; i++) {
+    int b = tbl[i]->get_hash() & (size - 1);
+    while (buckets[b] != NULL)
+      b = (b + 1) & (size - 1);
+    buckets[b] = tbl[i];
+  }
+}
+
+//
+// Adding a string requires two steps.  First, the hash index is searched;
+// if the string is found, a pointer to the existing Entry for that string
+// is returned.  If the string is not found, a new Entry is created and
+// added to the table.
 //
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s, int maxchars)
 {
   int len = min((int) strlen(s),maxchars);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  unsigned hash = Entry::hash_string(s,len);
+  std::lock_guard<std::mutex> guard(lock);
 
-  Elem *e = new Elem(s,len,index++);
-  tbl = new List<Elem>(e, tbl);
+  if (2 * (index + 1) > (int) buckets.size())
+    grow();
+  int b = find_bucket(s,len,hash);
+  if (buckets[b] != NULL)
+    return buckets[b];
+
+  void *mem = entry_arena.allocate(sizeof(Elem), alignof(Elem));
+  Elem *e = new (mem) Elem(string_arena.copy_string(s,len),len,index++);
+  tbl.push_back(e);
+  buckets[b] = e;
   return e;
 }
 
 //
-// To look up a string, the list is scanned until a matching Entry is located.
-// If no such entry is found, an assertion failure occurs.  Thus, this function
-// is used only for strings that one expects to find in the table.
+// To look up a string, the hash index is probed for a matching Entry.
+// If no such entry is found, an assertion failure occurs.  Thus, this
+// function is used only for strings that one expects to find in the table.
 //
 template <class Elem>
 Elem *StringTable<Elem>::lookup_string(char *s)
 {
   int len = strlen(s);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  std::lock_guard<std::mutex> guard(lock);
+  if (!buckets.empty()) {
+    int b = find_bucket(s,len,Entry::hash_string(s,len));
+    if (buckets[b] != NULL)
+      return buckets[b];
+  }
   assert(0);   // fail if string is not found
   return NULL; // to avoid compiler warning
 }
 
 //
 // lookup is similar to lookup_string, but uses the index of the string
-// as the key.
+// as the key.  Indices are dense, so this is a direct vector access.
 //
 template <class Elem>
 Elem *StringTable<Elem>::lookup(int ind)
 {
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_index(ind))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  std::lock_guard<std::mutex> guard(lock);
+  assert(ind >= 0 && ind < index);   // fail if string is not found
+  return tbl[ind];
 }
 
 //
@@ -77,8 +123,8 @@ Elem *StringTable<Elem>::lookup(int ind)
 template <class Elem>
 Elem *StringTable<Elem>::add_int(long i)
 {
-  static char *buf = new char[20];
-  snprintf(buf, 20, "%ld", i);
+  char buf[20];
+  snprintf(buf, sizeof(buf), "%ld", i);
   return add_string(buf);
 }
 template <class Elem>
@@ -100,8 +146,22 @@ int StringTable<Elem>::next(int i)
   return i+1;
 }
 
+template <class Elem>
+void StringTable<Elem>::print_stats(ostream& s, const char *name) const
+{
+  s << name << " (" << index << " entries)\n";
+  entry_arena.print_stats(s, "  entries");
+  string_arena.print_stats(s, "  strings");
+}
+
+//
+// print lists the newest Entry first, as the list-based table used to.
+//
 template <class Elem>
 void StringTable<Elem>::print()
 {
-  list_print(cerr,tbl);
+  cerr << "[\n";
+  for (int i = index - 1; i >= 0; i--)
+    cerr << *tbl[i] << " ";
+  cerr << "]\n";
 }
@@ -0,0 +1,94 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SYMMAP_H_
+#define _SYMMAP_H_
+
+#include <vector>
+#include "stringtab.h"
+
+//
+// SymbolMap<T> maps Symbols of one string table to values of type T.
+//
+//    It is one flat array of slots with open addressing.  A symbol's
+//    first slot is picked from its index in the string table, which is
+//    dense and never changes, and a search probes on slot by slot from
+//    there to the symbol or to an empty slot.  The array doubles when it
+//    would become more than half full, so searches stay short.  There are
+//    no nodes to allocate or chase.
+//
+//    `lookup(s)' returns a pointer to the value of `s', or NULL if `s' is
+//        not in the map.  It never changes the map, so threads may look
+//        up at the same time while nothing is inserted.
+//
+//    `insert(s,v)' maps `s' to `v', replacing any value it had.
+//
+//    `clear()' empties the map but keeps its slots for reuse.
+//
+
+template <class T>
+class SymbolMap {
+private:
+   struct Slot { Symbol key; T value; };   // key NULL: empty
+   std::vector<Slot> slots;                // a power of two of them, or none
+   int count;                              // slots in use
+
+   size_t first_slot(Symbol s) const
+   {
+      return ((unsigned) s->get_index() * 2654435761u) & (slots.size() - 1);
+   }
+
+   // the slot of s, or the empty slot where it would go
+   Slot &find(Symbol s)
+   {
+      size_t mask = slots.size() - 1;
+      size_t i = first_slot(s);
+      while (slots[i].key != NULL && slots[i].key != s)
+         i = (i + 1) & mask;
+      return slots[i];
+   }
+
+   void grow()
+   {
+      std::vector<Slot> old(slots.size() ? 2 * slots.size() : 16);
+      old.swap(slots);
+      for (size_t i = 0; i < old.size(); i++)
+         if (old[i].key != NULL)
+            find(old[i].key) = old[i];
+   }
+public:
+   SymbolMap() : count(0) { }
+
+   T *lookup(Symbol s)
+   {
+      if (count == 0)
+         return NULL;
+      Slot &slot = find(s);
+      return slot.key != NULL ? &slot.value : NULL;
+   }
+
+   void insert(Symbol s, T v)
+   {
+      if (2 * (count + 1) > (int) slots.size())
+         grow();
+      Slot &slot = find(s);
+      if (slot.key == NULL)
+         count++;
+      slot.key = s;
+      slot.value = v;
+   }
+
+   void clear()
+   {
+      for (size_t i = 0; i < slots.size(); i++)
+         slots[i].key = NULL;
+      count = 0;
+   }
+
+   int size() const { return count; }
+};
+
+#endif
@@ -0,0 +1,108 @@
+//
+// symmap_bench.cc
+//
+// Looks up function names the way the checker does for every call and
+// times the flat SymbolMap against the std::map FuncTable used to be.
+//
+//    % make symmap_bench
+//    % ./symmap_bench [functions [lookups]]
+//
+// "functions" names are interned and put in both maps, and then each map
+// is asked for "lookups" names drawn from them, as the calls of a large
+// program name the functions it declares.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <map>
+#include "stringtab.h"
+#include "symmap.h"
+
+// stringtab.o's dump_Symbol needs pad(); the benchmark does not link
+// utilities.o and never dumps.
+char *pad(int n) { return (char *) ""; }
+
+static double now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//
+// The two maps behind one interface.  The value stands for the Decl.
+//
+class TreeMap {
+   std::map<Symbol, void *> map;
+public:
+   void insert(Symbol s, void *v) { map[s] = v; }
+   void *lookup(Symbol s)
+   {
+      std::map<Symbol, void *>::iterator i = map.find(s);
+      return i != map.end() ? i->second : NULL;
+   }
+};
+
+class FlatMap {
+   SymbolMap<void *> map;
+public:
+   void insert(Symbol s, void *v) { map.insert(s, v); }
+   void *lookup(Symbol s)
+   {
+      void **v = map.lookup(s);
+      return v != NULL ? *v : NULL;
+   }
+};
+
+template <class Map>
+static void run(const char *what, Symbol *names, int functions,
+                Symbol *calls, int lookups)
+{
+   Map map;
+   double start = now();
+   for (int i = 0; i < functions; i++)
+      map.insert(names[i], &names[i]);
+   double inserted = now() - start;
+
+   long found = 0;
+   start = now();
+   for (int i = 0; i < lookups; i++)
+      found += map.lookup(calls[i]) != NULL;
+   double secs = now() - start;
+
+   printf("%-6s %8d functions %8.1f ns/insert %10d lookups %8.1f ns/lookup\n",
+          what, functions, inserted * 1e9 / functions, lookups,
+          secs * 1e9 / lookups);
+   if (found != lookups) {
+      cerr << what << ": lost " << lookups - found << " functions\n";
+      exit(1);
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   int functions = argc > 1 ? atoi(argv[1]) : 5000;
+   int lookups = argc > 2 ? atoi(argv[2]) : 10000000;
+
+   // other identifiers are interned between the functions, as in a program
+   Symbol *names = new Symbol[functions];
+   for (int i = 0; i < functions; i++) {
+      char buf[32];
+      snprintf(buf, sizeof buf, "local_%d", i);
+      idtable.add_string(buf);
+      snprintf(buf, sizeof buf, "f_%d", i);
+      names[i] = idtable.add_string(buf);
+   }
+
+   Symbol *calls = new Symbol[lookups];
+   unsigned seed = 12345;
+   for (int i = 0; i < lookups; i++) {
+      seed = seed * 1103515245 + 12345;
+      calls[i] = names[(seed >> 8) % functions];
+   }
+
+   run<TreeMap>("map", names, functions, calls, lookups);
+   run<FlatMap>("flat", names, functions, calls, lookups);
+   return 0;
+}
@@ -14,11 +14,16 @@
 #ifndef _SYMTAB_H_
 #define _SYMTAB_H_
 
-#include "list.h"
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+#include "seal-io.h"
 
 //
 // SymtabEnty<SYM,DAT> defines the entry for a symbol table that associates
-//    symbols of type `SYM' with data of type `DAT *'.  
+//    symbols of type `SYM' with data of type `DAT *'.  Each entry also
+//    records the depth of the scope it was added in and the entry for the
+//    same symbol that it shadows, if any.
 //
 
 template <class SYM, class DAT>
@@ -26,46 +31,46 @@ class SymtabEntry {
 private:
   SYM id;        // the key field
   DAT *info;     // associated information for the symbol
+  int depth;     // depth of the scope holding the entry; the outermost is 1
+  SymtabEntry<SYM,DAT> *shadowed;  // outer entry for id hidden by this one
 public:
-  SymtabEntry(SYM x, DAT *y) : id(x), info(y) { }
+  SymtabEntry(SYM x, DAT *y, int d = 0, SymtabEntry<SYM,DAT> *s = NULL)
+    : id(x), info(y), depth(d), shadowed(s) { }
   SYM get_id() const    { return id; }
   DAT *get_info() const { return info; }
+  int get_depth() const { return depth; }
+  SymtabEntry<SYM,DAT> *get_shadowed() const { return shadowed; }
 };
 
 //
 // SymbolTable<SYM,DAT> describes a symbol table mapping symbols of
-//    type `SYM' to data of type `DAT *'.  It is implemented as a
-//    list of lists of `SymtabEntry<SYM,DAT> *'.  The inner list is
-//    a scope, a mapping from symbols to data, and the outer list is
-//    a list of scopes. 
+//    type `SYM' to data of type `DAT *'.  It is implemented as a scope
+//    stack: a hash table maps each symbol to its innermost entry, each
+//    entry points to the entry it shadows, and an undo log records the
+//    entries in the order they were added.  Symbols are compared (and
+//    hashed) by value, so for interned Symbols the pointer is the key.
 //
-//    `tbl' points to the current top scope.
+//    `scopes' holds, for every open scope, the length of the undo log
+//        when the scope was entered.
 //
-//    `enterscope' makes the table point to a new scope whose parent
-//       is the scope it pointed to previously.
+//    `enterscope' opens a new scope nested in the current one.
 //
-//    `exitscope' makes the table point to the parent scope of the
-//        current scope.  Note that the old child scope is not
-//        deallocated.  One may save the state of a symbol table
-//        at a given point by copying it with `operator ='
+//    `exitscope' closes the current scope.  Its entries are popped off
+//        the undo log and each symbol's binding is restored to the entry
+//        it shadowed.  The popped entries are deallocated.  One may save
+//        the state of a symbol table at a given point by copying it with
+//        `operator ='; the copy is independent of the original.
 //
 //    `addid(s,i)' adds a symbol table entry to the current scope of
-//        the symbol table mapping symbol `s' to data `d'.  The old
-//        top scope isn't modified; a new scope is created whose
-//        entry list is the new entry followed by the old entry list,
-//        and whose tail is the old top scope's parent.  The table
-//        is made to point to this new scope.
+//        the symbol table mapping symbol `s' to data `i'.  The new entry
+//        shadows any entry for `s' already in the table.  The returned
+//        entry is valid until its scope is exited.
 //
-//    `lookup(s)' looks for the symbol `s', starting at the top scope
-//        and proceeding down the list of scopes until either an
-//        entry is found whose `get_id()' equals `s', or the end of
-//        the root scope is reached.  It returns the data item
-//        associated with the entry, or NULL if no such entry exists.
+//    `lookup(s)' returns the data item of the innermost entry for `s',
+//        or NULL if no such entry exists.  This is a single hash lookup.
 //
-//    
-//    `probe(s)' checks the top scope for an entry whose `get_id()'
-//        equals `s', and returns the entry's `get_info()' if
-//        found, and NULL otherwise.
+//    `probe(s)' returns the innermost entry's `get_info()' if that entry
+//        is in the current scope, and NULL otherwise.
 //
 //    `dump()' prints the symbols in the symbol table.
 //
@@ -74,15 +79,56 @@ template <class SYM, class DAT>
 class SymbolTable
 {
    typedef SymtabEntry<SYM,DAT> ScopeEntry;
-   typedef List<ScopeEntry> Scope;
-   typedef List<Scope> ScopeList;
 private:
-   ScopeList  *tbl;
+   std::unordered_map<SYM, ScopeEntry *> bindings;  // innermost entry per symbol
+   std::vector<ScopeEntry *> undo;    // entries, oldest first
+   std::vector<size_t> scopes;        // undo.size() when each scope was entered
+
+   // Bind a new entry for s at the given depth on top of its current one.
+   ScopeEntry *push(SYM s, DAT *i, int depth)
+   {
+       ScopeEntry *&binding = bindings[s];
+       ScopeEntry *se = new ScopeEntry(s, i, depth, binding);
+       binding = se;
+       undo.push_back(se);
+       return se;
+   }
+
+   // Pop entries off the undo log until only n remain.
+   void unwind(size_t n)
+   {
+       while (undo.size() > n) {
+	   ScopeEntry *se = undo.back();
+	   undo.pop_back();
+	   if (se->get_shadowed())
+	       bindings[se->get_id()] = se->get_shadowed();
+	   else
+	       bindings.erase(se->get_id());
+	   delete se;
+       }
+   }
+
+   void copy_from(const SymbolTable &s)
+   {
+       for (size_t i = 0; i < s.undo.size(); i++)
+	   push(s.undo[i]->get_id(), s.undo[i]->get_info(), s.undo[i]->get_depth());
+       scopes = s.scopes;
+   }
 public:
-   SymbolTable(): tbl(NULL) { }     // create a new symbol table
+   SymbolTable() { }     // create a new symbol table
+   SymbolTable(const SymbolTable &s) { copy_from(s); }
+   ~SymbolTable() { unwind(0); }
 
-   // Create pointer to current symbol table.
-   SymbolTable &operator =(const SymbolTable &s) { tbl = s.tbl; return *this; }
+   // Copy the current state of a symbol table.
+   SymbolTable &operator =(const SymbolTable &s)
+   {
+       if (this != &s) {
+	   unwind(0);
+	   scopes.clear();
+	   copy_from(s);
+       }
+       return *this;
+   }
 
    void fatal_error(char * msg)
    {
@@ -90,36 +136,31 @@ public:
      exit(1);
    } 
 
-   // Enter a new scope.  A symbol table is organized as a list of
-   // lists.  The head of the list is the innermost scope, the tail
-   // holds the outer scopes.  A scope must be entered before anything
-   // can be added to the table.
+   // Enter a new scope.  A scope must be entered before anything can be
+   // added to the table.
 
    void enterscope()
    {
-       // The cast of NULL is required for template instantiation to work
-       // correctly.
-       tbl = new ScopeList((Scope *) NULL, tbl);
+       scopes.push_back(undo.size());
    }
 
    // Pop the first scope off of the symbol table.
    void exitscope()
    {
        // It is an error to exit a scope that doesn't exist.
-       if (tbl == NULL) {
+       if (scopes.empty()) {
 	   fatal_error("exitscope: Can't remove scope from an empty symbol table.");
        }
-       tbl = tbl->tl();
+       unwind(scopes.back());
+       scopes.pop_back();
    }
 
    // Add an item to the symbol table.
    ScopeEntry *addid(SYM s, DAT *i)
    {
        // There must be at least one scope to add a symbol.
-       if (tbl == NULL) fatal_error("addid: Can't add a symbol without a scope.");
-       ScopeEntry * se = new ScopeEntry(s,i);
-       tbl = new ScopeList(new Scope(se, tbl->hd()), tbl->tl());
-       return(se);
+       if (scopes.empty()) fatal_error("addid: Can't add a symbol without a scope.");
+       return push(s, i, scopes.size());
    }
    
    // Lookup an item through all scopes of the symbol table.  If found
@@ -128,43 +169,38 @@ public:
 
    DAT * lookup(SYM s)
    {
-       for(ScopeList *i = tbl; i != NULL; i=i->tl()) {
-	   for( Scope *j = i->hd(); j != NULL; j = j->tl()) {
-	       if (s == j->hd()->get_id()) {
-		   return (j->hd()->get_info());
-	       }
-	   }
-       }
-       return NULL;
+       typename std::unordered_map<SYM, ScopeEntry *>::iterator i = bindings.find(s);
+       if (i == bindings.end())
+	   return NULL;
+       return i->second->get_info();
    }
 
    // probe the symbol table.  Check the top scope (only) for the item
    // 's'.  If found, return the information field.  If not return NULL.
    DAT *probe(SYM s)
    {
-       if (tbl == NULL) {
+       if (scopes.empty()) {
 	   fatal_error("probe: No scope in symbol table.");
        }
-       for(Scope *i = tbl->hd(); i != NULL; i = i->tl()) {
-	   if (s == i->hd()->get_id()) {
-	       return(i->hd()->get_info());
-	   }
-       }
-       return(NULL);
+       typename std::unordered_map<SYM, ScopeEntry *>::iterator i = bindings.find(s);
+       if (i == bindings.end() || i->second->get_depth() != (int) scopes.size())
+	   return NULL;
+       return i->second->get_info();
    }
 
-   // Prints out the contents of the symbol table  
+   // Prints out the contents of the symbol table, innermost scope first
    void dump()
    {
-      for(ScopeList *i = tbl; i != NULL; i = i->tl()) {
+      size_t end = undo.size();
+      for (size_t k = scopes.size(); k > 0; k--) {
          cerr << "\nScope: \n";
-         for(Scope *j = i->hd(); j != NULL; j = j->tl()) {
-            cerr << "  " << j->hd()->get_id() << endl;
+         for (size_t j = end; j > scopes[k-1]; j--) {
+            cerr << "  " << undo[j-1]->get_id() << endl;
          }
+         end = scopes[k-1];
       }
    }
  
 };
 
 #endif
-
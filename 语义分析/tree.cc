@@ -0,0 +1,138 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: tree.cc
+//
+// This file defines the basic class of tree node
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <cxxabi.h>
+#include <stdlib.h>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include "tree.h"
+
+/* line number to assign to the current node being constructed */
+thread_local int node_lineno = 1;
+
+/* the arena tree nodes are allocated from, one per thread */
+static thread_local AstArena default_ast_arena;
+thread_local AstArena *ast_arena = &default_ast_arena;
+
+///////////////////////////////////////////////////////////////////////////
+//
+// tree_node::tree_node
+//
+// constructor of tree node
+//
+///////////////////////////////////////////////////////////////////////////
+tree_node::tree_node()
+{
+    line_number = node_lineno;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// tree_node::get_line_number
+//
+///////////////////////////////////////////////////////////////////////////
+int tree_node::get_line_number()
+{	
+	return line_number;
+}
+
+//
+// Set up common area from existing node
+//
+tree_node *tree_node::set(tree_node *t) {
+   line_number = t->line_number;
+   return this;
+}
+
+void tree_node::shift_line_number(int lines) {
+   line_number += lines;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// tree_node::operator new
+//
+// allocate a tree node from the current AST arena
+//
+///////////////////////////////////////////////////////////////////////////
+void *tree_node::operator new(size_t size)
+{
+   return ast_arena->allocate(size);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AstArena
+//
+///////////////////////////////////////////////////////////////////////////
+AstArena::AstArena() : arena(new StringArena()) { }
+
+AstArena::~AstArena()
+{
+   release();
+   delete arena;
+}
+
+//
+// Nodes hold only pointers and ints, so pointer alignment is enough.
+//
+void *AstArena::allocate(size_t size)
+{
+   void *p = arena->allocate(size, alignof(void *));
+   Node n = { (tree_node *) p, size };
+   nodes.push_back(n);
+   return p;
+}
+
+//
+// Destroy the nodes newest first, so that no node outlives one that was
+// built before it, then drop all chunks at once.
+//
+void AstArena::release()
+{
+   for (size_t i = nodes.size(); i > 0; i--)
+      nodes[i-1].node->~tree_node();
+   nodes.clear();
+   delete arena;
+   arena = new StringArena();
+}
+
+//
+// Print the number of nodes and bytes used by each node class,
+// followed by the arena's own totals.
+//
+void AstArena::print_stats(ostream& s) const
+{
+   std::map<std::string, std::pair<int, size_t> > classes;
+
+   for (size_t i = 0; i < nodes.size(); i++) {
+      const char *mangled = typeid(*nodes[i].node).name();
+      int status;
+      char *name = abi::__cxa_demangle(mangled, NULL, NULL, &status);
+      std::pair<int, size_t> &c = classes[status == 0 ? name : mangled];
+      free(name);
+      c.first++;
+      c.second += nodes[i].size;
+   }
+
+   s << "AST (" << nodes.size() << " nodes)\n";
+   for (std::map<std::string, std::pair<int, size_t> >::const_iterator
+           i = classes.begin(); i != classes.end(); ++i)
+      s << "  " << setw(40) << std::left << i->first << std::right
+        << setw(8) << i->second.first << " nodes "
+        << setw(10) << i->second.second << " bytes\n";
+   arena->print_stats(s, "  AST arena");
+}
@@ -0,0 +1,703 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef TREE_H
+#define TREE_H
+///////////////////////////////////////////////////////////////////////////
+//
+// file: tree.h
+//
+// This file defines the basic class of tree node and list
+//
+///////////////////////////////////////////////////////////////////////////
+ 
+
+#include <vector>
+#include "stringtab.h"
+#include "seal-io.h"
+
+/////////////////////////////////////////////////////////////////////
+//
+//  tree_node
+//
+//   All APS nodes are derived from tree_node.  There is a
+//   protected field:
+//       int line_number     line in the source file from which this node came;
+//                           this is read from a global variable when the
+//                           node is created.
+//      
+//
+//
+//   The public methods are:
+//       tree_node()
+//         builds a new tree_node.  The type field is NULL, the
+//         line_number is set to the value of the global yylineno.
+//
+//       void dump(ostream& s,int n); 
+//         dump is a pretty printer for tree nodes.  The ostream argument
+//         is the output stream on which the node is to be printed; n is
+//         the number of spaces to indent the output.
+//
+//       int get_line_number();  return the line number
+//       Symbol get_type();      return the type 
+//
+//       tree_node *set(tree_node *t)
+//           sets the line number and type of "this" to the values in
+//           the argument tree_node.  Returns "this".
+//
+//   Tree nodes are allocated from ast_arena (see AstArena below);
+//   deleting a single node does not free anything.
+//
+//
+////////////////////////////////////////////////////////////////////////////
+class tree_node {
+protected:
+    int line_number;            // stash the line number when node is made
+public:
+    tree_node();
+    virtual tree_node *copy() = 0;
+    virtual ~tree_node() { }
+    virtual void dump(ostream& stream, int n) = 0;
+    int get_line_number();
+    tree_node *set(tree_node *);
+    void shift_line_number(int lines);  // the source moved by lines
+
+    static void *operator new(size_t size);
+    static void operator delete(void *) { }
+};
+
+///////////////////////////////////////////////////////////////////
+//
+//  AstArena
+//
+//   The nodes of one compilation are bump-allocated from an AstArena
+//   and freed together: release() runs the destructors of all nodes
+//   allocated so far and returns their memory in one go, as does
+//   deleting the arena.  ast_arena is the arena new nodes come from;
+//   each thread has its own.
+//
+//   print_stats reports how many nodes of each class were allocated
+//   and the bytes they use.
+//
+///////////////////////////////////////////////////////////////////
+class AstArena {
+private:
+    struct Node { tree_node *node; size_t size; };
+    StringArena *arena;
+    std::vector<Node> nodes;    // every node allocated, oldest first
+
+    AstArena(const AstArena &);             // not copyable
+    AstArena &operator =(const AstArena &);
+public:
+    AstArena();
+    ~AstArena();
+    void *allocate(size_t size);
+    int node_count() const { return nodes.size(); }
+    tree_node *nth_node(int i) const { return nodes[i].node; }
+    void release();
+    void print_stats(ostream& s) const;
+};
+
+extern thread_local AstArena *ast_arena;
+
+///////////////////////////////////////////////////////////////////
+//
+//  Lists of APS objects are implemented by the "list_node"
+//  template.  List elements have type Elem.  The interface is:
+//
+//     tree_node *copy()
+//     list_node<Elem> *copy_list()
+//
+//     These functions have identical behavior; they return a deep
+//     copy of the list (i.e., all elements of the list are copied).
+//     When possible, the second function should be used, as it
+//     has a more accurate result type.  The "copy" function is for
+//     copying an entire APS tree of which a list is just one component
+//     (see the definition of copy() in class tree_node).
+//
+//     Elem nth(int n);
+//     returns the nth element of a list.  If the list has fewer than n
+//     elements, an error is generated.
+//
+//     int first();
+//     int next(int n);
+//     int more(int n);
+//       These three functions define a simple iterator for stepping through
+//     list elements in order.  If l is a list, a typical use would be:
+//
+//     for(int i = l->first(); l->more(i); i = l->next(i))
+//         ... operate on l->nth(i) ...
+//
+//     iterator begin();
+//     iterator end();
+//       The same traversal with a range-based for loop:
+//
+//     for(Elem e : *l)
+//         ... operate on e ...
+//
+//     int len()
+//     returns the length of the list
+//
+//     nth_length(int n, int &len);
+//     Returns the nth element of the list or NULL if there are not n elements.
+//     "len" is set to the length of the list.  This method is used internally
+//     by the APS package to efficiently traverse the list representation.  
+//
+//     nth, len and nth_length take constant time.  An append_node flattens
+//     the elements of its whole subtree into a vector the first time one
+//     of them is asked for, and answers from that vector afterwards.
+//     Lists are never modified once they are part of a flattened list, so
+//     the vector stays valid; see add, below.
+//
+//     list_node<Elem> *add(Elem e);
+//     returns the list with e appended.  A vector_list_node keeps its
+//     elements in a growable vector and adds e to it in place, in
+//     amortized constant time; the other lists return a new
+//     vector_list_node of their elements followed by e.  So a list built
+//     up by add, as the parser's left-recursive list rules build theirs,
+//     is one flat vector rather than a chain of append_nodes.  Since the
+//     list is changed in place, only the code building a list may add to
+//     it, and only to the list add last returned.  Once an append_node
+//     has flattened a vector_list_node, the vector is frozen: add then
+//     returns a new list, as for the other lists, so that the append_node
+//     still holds what the list held.
+//
+//     static list_node<Elem> *nil();
+//     static list_node<Elem> *single(Elem);
+//     static list_node<Elem> *append(list_node<Elem> *, list_node<Elem> *);
+//
+//     These three functions construct an empty list, a list of one element,
+//     and append two lists, respectively.  Note that the functions are static;
+//     there is no "this" parameter.  Example uses:
+//
+//     list_node<Elem>::nil();
+//     list_node<Elem>::single(e);     where "e" has type Elem
+//     list_node<Elem>::append(l1,l2);
+//
+//////////////////////////////////////////////////////////////////////////////
+
+template <class Elem> class list_node : public tree_node {
+public:
+    tree_node *copy()            { return copy_list(); }
+    Elem nth(int n);
+    //
+    // The next three define a simple iterator.
+    //
+    int first()      { return 0; }
+    int next(int n)  { return n + 1; }
+    int more(int n)  { return (n < len()); }
+
+    class iterator {
+        list_node<Elem> *list;
+        int n;
+    public:
+        iterator(list_node<Elem> *l, int i) : list(l), n(i) { }
+        Elem operator*() const   { return list->nth(n); }
+        iterator &operator++()   { n++; return *this; }
+        bool operator!=(const iterator &i) const { return n != i.n; }
+    };
+    iterator begin() { return iterator(this, 0); }
+    iterator end()   { return iterator(this, len()); }
+
+    virtual list_node<Elem> *copy_list() = 0;
+    virtual ~list_node() { }
+    virtual int len() = 0;
+    virtual Elem nth_length(int n, int &len) = 0;
+
+    // Add the elements of this list to the end of "out".  Sublists that
+    // still have to be expanded are pushed on "pending" instead, so that
+    // deep append trees are flattened without recursion.
+    virtual void flatten_into(std::vector<Elem> &out,
+                              std::vector<list_node<Elem> *> &pending) = 0;
+
+    static list_node<Elem> *nil();
+    static list_node<Elem> *single(Elem);
+    static list_node<Elem> *append(list_node<Elem> *l1,list_node<Elem> *l2);
+
+    virtual list_node<Elem> *add(Elem e);
+};
+
+char *pad(int n);
+
+extern int info_size;
+
+template <class Elem> class nil_node : public list_node<Elem> {
+public:
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &, std::vector<list_node<Elem> *> &) { }
+    void dump(ostream& stream, int n);
+};
+
+template <class Elem> class single_list_node : public list_node<Elem> {
+    Elem elem;
+public:
+    single_list_node(Elem t) {
+	elem = t;
+    }
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &)
+        { out.push_back(elem); }
+    void dump(ostream& stream, int n);
+};
+
+
+template <class Elem> class append_node : public list_node<Elem> {
+private:
+    list_node<Elem> *some, *rest;
+    std::vector<Elem> *flat;    // all elements, built on first use
+    std::vector<Elem> &elems();
+public:
+    append_node(list_node<Elem> *l1, list_node<Elem> *l2) {
+	some = l1;
+	rest = l2;
+	flat = NULL;
+    }
+    ~append_node() { delete flat; }
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth(int n);
+    Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &pending);
+    void dump(ostream& stream, int n);
+};
+
+
+template <class Elem> class vector_list_node : public list_node<Elem> {
+private:
+    std::vector<Elem> elems;
+    bool frozen;                // flattened into an append_node
+public:
+    vector_list_node() { frozen = false; }
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth(int n);
+    Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &)
+        { frozen = true; out.insert(out.end(), elems.begin(), elems.end()); }
+    list_node<Elem> *add(Elem e);
+    void dump(ostream& stream, int n);
+};
+
+
+template <class Elem> single_list_node<Elem> *list(Elem x);
+template <class Elem> append_node<Elem> *cons(Elem x, list_node<Elem> *l);
+template <class Elem> append_node<Elem> *xcons(list_node<Elem> *l, Elem x);
+
+
+template <class Elem> list_node<Elem> *list_node<Elem>::nil() { return new nil_node<Elem>(); }
+template <class Elem> list_node<Elem> *list_node<Elem>::single(Elem e) { return new single_list_node<Elem>(e); }
+template <class Elem> list_node<Elem> *list_node<Elem>::append(list_node<Elem> *l1,list_node<Elem> *l2) {
+   return new append_node<Elem>(l1,l2);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_node::nth
+//
+// function to find the nth element of the list
+//
+///////////////////////////////////////////////////////////////////////////
+
+template <class Elem> Elem list_node<Elem>::nth(int n)
+{
+    int len;
+    Elem tmp = nth_length(n ,len);
+
+    if (tmp)
+	return tmp;
+    else {
+	cerr << "error: outside the range of the list\n";
+	exit(1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_node::add
+//
+// return a vector_list_node of the elements of the list followed by e
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *list_node<Elem>::add(Elem e)
+{
+    list_node<Elem> *l = new vector_list_node<Elem>();
+    for (int i = 0; i < len(); i++)
+	l->add(nth(i));
+    return l->add(e);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::add
+//
+// append e in place, or to a copy once the list is frozen
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::add(Elem e)
+{
+    if (frozen)
+	return list_node<Elem>::add(e);
+    elems.push_back(e);
+    return this;
+}
+
+// added 10/30/06 cgs
+template <class Elem> Elem append_node<Elem>::nth(int n)
+{
+    int len;
+    Elem tmp = nth_length(n ,len);
+
+    if (tmp)
+	return tmp;
+    else {
+	cerr << "error: outside the range of the list\n";
+	exit(1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// nil_node::copy_list
+//
+// return the deep copy of the nil_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *nil_node<Elem>::copy_list()
+{
+    return new nil_node<Elem>();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// nil_node::len
+//
+// return the length of the nil_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int nil_node<Elem>::len()
+{
+    return 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// nil_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem nil_node<Elem>::nth_length(int, int &len)
+{
+    len = 0;
+    return NULL;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// nil_node::dump
+//
+// dump for list node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void nil_node<Elem>::dump(ostream& stream, int n)
+{
+    stream << pad(n) << "(nil)\n";
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// single_list_node::copy_list
+//
+// return the deep copy of the single_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *single_list_node<Elem>::copy_list()
+{
+    return new single_list_node<Elem>((Elem) elem->copy());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// single_list_node::len
+//
+// return the length of the single_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int single_list_node<Elem>::len()
+{
+    return 1;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// single_list_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem single_list_node<Elem>::nth_length(int n, int &len)
+{
+    len = 1;
+    if (n)
+	return NULL;
+    else
+	return elem;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// single_list_node::dump
+//
+// dump for list node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void single_list_node<Elem>::dump(ostream& stream, int n)
+{
+    elem->dump(stream, n);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::copy_list
+//
+// return the deep copy of the append_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *append_node<Elem>::copy_list()
+{
+    return new append_node<Elem>(some->copy_list(), rest->copy_list());
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::len
+//
+// return the length of the append_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int append_node<Elem>::len()
+{
+    return elems().size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem append_node<Elem>::nth_length(int n, int &len)
+{
+    std::vector<Elem> &v = elems();
+
+    len = v.size();
+    if (n < 0 || n >= len)
+	return NULL;
+    return v[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::elems
+//
+// return the elements of the append_node, flattening it the first time
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> std::vector<Elem> &append_node<Elem>::elems()
+{
+    if (!flat) {
+	std::vector<list_node<Elem> *> pending;
+	flat = new std::vector<Elem>();
+	pending.push_back(this);
+	while (!pending.empty()) {
+	    list_node<Elem> *l = pending.back();
+	    pending.pop_back();
+	    if (l == this) {
+		pending.push_back(rest);
+		pending.push_back(some);
+	    } else
+		l->flatten_into(*flat, pending);
+	}
+    }
+    return *flat;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::flatten_into
+//
+// add the elements of the append_node to a flattening in progress
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void append_node<Elem>::flatten_into(std::vector<Elem> &out,
+                                                           std::vector<list_node<Elem> *> &pending)
+{
+    if (flat)
+	out.insert(out.end(), flat->begin(), flat->end());
+    else {
+	pending.push_back(rest);
+	pending.push_back(some);
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::dump
+//
+// dump for list node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void append_node<Elem>::dump(ostream& stream, int n)
+{
+    int i, size;
+
+    size = len();
+    stream << pad(n) << "list\n";
+    for (i = 0; i < size; i++)
+      nth(i)->dump(stream, n+2);
+    stream << pad(n) << "(end_of_list)\n";
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::copy_list
+//
+// return the deep copy of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::copy_list()
+{
+    vector_list_node<Elem> *l = new vector_list_node<Elem>();
+    l->elems.reserve(elems.size());
+    for (size_t i = 0; i < elems.size(); i++)
+	l->elems.push_back((Elem) elems[i]->copy());
+    return l;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::len
+//
+// return the length of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int vector_list_node<Elem>::len()
+{
+    return elems.size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::nth
+//
+// return the nth element, without the virtual call to nth_length
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem vector_list_node<Elem>::nth(int n)
+{
+    if (n < 0 || n >= (int) elems.size()) {
+	cerr << "error: outside the range of the list\n";
+	exit(1);
+    }
+    return elems[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem vector_list_node<Elem>::nth_length(int n, int &len)
+{
+    len = elems.size();
+    if (n < 0 || n >= len)
+	return NULL;
+    return elems[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::dump
+//
+// dump for list node, the same as for the single_list_node or the
+// append_nodes holding the same elements
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void vector_list_node<Elem>::dump(ostream& stream, int n)
+{
+    if (elems.empty())
+	stream << pad(n) << "(nil)\n";
+    else if (elems.size() == 1)
+	elems[0]->dump(stream, n);
+    else {
+	stream << pad(n) << "list\n";
+	for (size_t i = 0; i < elems.size(); i++)
+	    elems[i]->dump(stream, n+2);
+	stream << pad(n) << "(end_of_list)\n";
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> single_list_node<Elem> *list(Elem x)
+{
+    return new single_list_node<Elem>(x);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// cons
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> append_node<Elem> *cons(Elem x, list_node<Elem> *l)
+{
+    return new append_node<Elem>(list(x), l);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// xcons
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> append_node<Elem> *xcons(list_node<Elem> *l, Elem x)
+{
+    return new append_node<Elem>(l, list(x));
+}
+
+#endif /* TREE_H */
@@ -0,0 +1,282 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: vm.cc
+//
+// The virtual machine that runs bytecode (-x).  Dispatch is threaded:
+// every handler ends by jumping straight to the handler of the next
+// instruction through a table of label addresses (a GNU extension), so
+// there is no loop and no switch, and each handler has its own indirect
+// jump for the branch predictor to learn.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "bytecode.h"
+
+//
+// Registers of all active calls are on one stack, each call's above its
+// caller's.  The pages of the stack are not touched until used.
+//
+const size_t stack_values = 1 << 22;
+const size_t max_calls = 1 << 20;
+
+struct Frame {
+    const Insn *pc;                     // the CALL to return to
+    Value *regs;                        // the caller's registers
+    const BytecodeFunction *function;
+};
+
+//
+// printf is C's, one conversion at a time: each % conversion takes the
+// next argument, converted to what the conversion wants, so an Int is
+// printed whole with %ld and by its low 32 bits with %d, as in C.
+//
+static bool print_one(std::string &spec, char conv, const Value &v, char type)
+{
+    if (strchr("diouxXc", conv)) {
+        long long n = type == 'f' ? (long long) v.f : v.i;
+        if (conv != 'c' && spec.find_first_of("ljzqtL") != std::string::npos) {
+            // whatever length it asked for, it gets a long long
+            std::string::size_type at = spec.find_first_of("hljzqtL");
+            spec = spec.substr(0, at) + "ll" + conv;
+            printf(spec.c_str(), n);
+        } else {
+            printf(spec.c_str(), (int) n);
+        }
+    } else if (strchr("fFeEgGaA", conv)) {
+        std::string::size_type at = spec.find_first_of("hljzqtL");
+        if (at != std::string::npos)
+            spec = spec.substr(0, at) + conv;
+        printf(spec.c_str(), type == 'f' ? v.f : (double) v.i);
+    } else if (conv == 's') {
+        printf(spec.c_str(), type == 's' ? v.s : "(null)");
+    } else if (conv == 'p') {
+        printf(spec.c_str(), (const void *) v.s);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void print(const Value *args, int n, const char *types)
+{
+    const char *f = args[0].s;
+    int next = 1;
+    while (*f != '\0') {
+        const char *percent = strchr(f, '%');
+        if (percent == NULL) {
+            fputs(f, stdout);
+            return;
+        }
+        fwrite(f, 1, percent - f, stdout);
+        // flags, width, precision and length, then the conversion
+        f = percent + 1;
+        f += strspn(f, "-+ #0");
+        f += strspn(f, "0123456789");
+        if (*f == '.') {
+            f++;
+            f += strspn(f, "0123456789");
+        }
+        f += strspn(f, "hljzqtL");
+        char conv = *f;
+        if (conv == '\0') {
+            fputs(percent, stdout);
+            return;
+        }
+        f++;
+        if (conv == '%') {
+            putchar('%');
+            continue;
+        }
+        std::string spec(percent, f - percent);
+        if (next >= n || !print_one(spec, conv, args[next], types[next]))
+            fputs(spec.c_str(), stdout);     // printed as it is
+        else
+            next++;
+    }
+}
+
+int run_bytecode(Bytecode &program)
+{
+#define BYTECODE_LABEL(name) &&do_##name,
+    static const void *const handlers[OP_COUNT] = { BYTECODE_OPS(BYTECODE_LABEL) };
+#undef BYTECODE_LABEL
+
+    if (program.main < 0) {
+        cerr << "Function main is not defined.\n";
+        return 1;
+    }
+    Value *stack = (Value *) calloc(stack_values, sizeof(Value));
+    Value *stack_end = stack + stack_values;
+    Value *globals = (Value *) calloc(program.globals + 1, sizeof(Value));
+    Frame *frames = (Frame *) malloc(max_calls * sizeof(Frame));
+    if (stack == NULL || globals == NULL || frames == NULL) {
+        cerr << "Out of memory.\n";
+        return 1;
+    }
+    Frame *frame = frames;              // the caller's, once there is one
+    const long long *ints = program.ints.data();
+    const double *floats = program.floats.data();
+    const char *const *strings = program.strings.data();
+    const BytecodeFunction *functions = program.functions.data();
+
+    const BytecodeFunction *function = &functions[program.main];
+    const Insn *code = function->code.data();
+    const Insn *pc = code;
+    Value *r = stack;
+    const char *fault = NULL;
+    int status = 0;
+
+#define DISPATCH()  goto *handlers[pc->op]
+#define NEXT()      do { pc++; DISPATCH(); } while (0)
+#define JUMP()      do { pc = code + pc->c; DISPATCH(); } while (0)
+#define A           r[pc->a]
+#define B           r[pc->b]
+#define C           r[pc->c]
+// Ints wrap around on overflow
+#define WRAP(e)     ((long long) (unsigned long long) (e))
+#define U(v)        ((unsigned long long) (v).i)
+
+    if (function->regs > (int) stack_values) {
+        fault = "Stack overflow.";
+        goto failed;
+    }
+    DISPATCH();
+
+do_MOV:     A = B; NEXT();
+do_LOADI:   A.i = pc->b; NEXT();
+do_LOADK:   A.i = ints[pc->b]; NEXT();
+do_LOADF:   A.f = floats[pc->b]; NEXT();
+do_LOADS:   A.s = strings[pc->b]; NEXT();
+do_GETG:    A = globals[pc->b]; NEXT();
+do_SETG:    globals[pc->a] = B; NEXT();
+
+do_ADD:     A.i = WRAP(U(B) + U(C)); NEXT();
+do_SUB:     A.i = WRAP(U(B) - U(C)); NEXT();
+do_MUL:     A.i = WRAP(U(B) * U(C)); NEXT();
+do_DIV:
+    if (C.i == 0) {
+        fault = "Division by zero.";
+        goto failed;
+    }
+    A.i = C.i == -1 ? WRAP(-U(B)) : B.i / C.i;
+    NEXT();
+do_MOD:
+    if (C.i == 0) {
+        fault = "Division by zero.";
+        goto failed;
+    }
+    A.i = C.i == -1 ? 0 : B.i % C.i;
+    NEXT();
+do_ADDI:    A.i = WRAP(U(B) + (unsigned long long) (long long) pc->c); NEXT();
+do_ADDF:    A.f = B.f + C.f; NEXT();
+do_SUBF:    A.f = B.f - C.f; NEXT();
+do_MULF:    A.f = B.f * C.f; NEXT();
+do_DIVF:    A.f = B.f / C.f; NEXT();
+do_NEG:     A.i = WRAP(-U(B)); NEXT();
+do_NEGF:    A.f = -B.f; NEXT();
+do_I2F:     A.f = (double) B.i; NEXT();
+do_BAND:    A.i = B.i & C.i; NEXT();
+do_BOR:     A.i = B.i | C.i; NEXT();
+do_BNOT:    A.i = ~B.i; NEXT();
+do_NOT:     A.i = !B.i; NEXT();
+do_XOR:     A.i = B.i ^ C.i; NEXT();
+
+do_LT:      A.i = B.i < C.i; NEXT();
+do_LE:      A.i = B.i <= C.i; NEXT();
+do_EQ:      A.i = B.i == C.i; NEXT();
+do_NE:      A.i = B.i != C.i; NEXT();
+do_LTF:     A.i = B.f < C.f; NEXT();
+do_LEF:     A.i = B.f <= C.f; NEXT();
+do_EQF:     A.i = B.f == C.f; NEXT();
+do_NEF:     A.i = B.f != C.f; NEXT();
+do_LTS:     A.i = strcmp(B.s, C.s) < 0; NEXT();
+do_LES:     A.i = strcmp(B.s, C.s) <= 0; NEXT();
+do_EQS:     A.i = strcmp(B.s, C.s) == 0; NEXT();
+do_NES:     A.i = strcmp(B.s, C.s) != 0; NEXT();
+
+do_JMP:     JUMP();
+do_JT:      if (A.i) JUMP(); NEXT();
+do_JF:      if (!A.i) JUMP(); NEXT();
+do_JLT:     if (A.i < B.i) JUMP(); NEXT();
+do_JLE:     if (A.i <= B.i) JUMP(); NEXT();
+do_JEQ:     if (A.i == B.i) JUMP(); NEXT();
+do_JNE:     if (A.i != B.i) JUMP(); NEXT();
+do_JLTI:    if (A.i < pc->b) JUMP(); NEXT();
+do_JLEI:    if (A.i <= pc->b) JUMP(); NEXT();
+do_JGTI:    if (A.i > pc->b) JUMP(); NEXT();
+do_JGEI:    if (A.i >= pc->b) JUMP(); NEXT();
+do_JEQI:    if (A.i == pc->b) JUMP(); NEXT();
+do_JNEI:    if (A.i != pc->b) JUMP(); NEXT();
+
+do_CALL: {
+    const BytecodeFunction *callee = &functions[pc->b];
+    Value *regs = r + pc->c;
+    if (frame == frames + max_calls || regs + callee->regs > stack_end) {
+        fault = "Stack overflow.";
+        goto failed;
+    }
+    frame->pc = pc;
+    frame->regs = r;
+    frame->function = function;
+    frame++;
+    function = callee;
+    code = callee->code.data();
+    pc = code;
+    r = regs;
+    DISPATCH();
+}
+do_PRINTF:
+    print(&A, pc->b, strings[pc->c]);
+    NEXT();
+do_RET: {
+    Value v = A;
+    if (frame == frames)
+        goto done;
+    frame--;
+    pc = frame->pc;
+    r = frame->regs;
+    function = frame->function;
+    code = function->code.data();
+    A = v;
+    NEXT();
+}
+do_RETV:
+    if (frame == frames)
+        goto done;
+    frame--;
+    pc = frame->pc;
+    r = frame->regs;
+    function = frame->function;
+    code = function->code.data();
+    NEXT();
+
+#undef DISPATCH
+#undef NEXT
+#undef JUMP
+#undef A
+#undef B
+#undef C
+#undef WRAP
+#undef U
+
+failed:
+    fflush(stdout);
+    cerr << function->lines[pc - code] << ": " << fault << endl;
+    status = 1;
+done:
+    fflush(stdout);
+    free(frames);
+    free(globals);
+    free(stack);
+    return status;
+}
@@ -0,0 +1,29 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+//
+// Batch mode: compile several input files on a pool of worker processes.
+//
+// Every file is compiled by compile() in a child process of its own, so
+// the lexer, parser and semant globals start fresh for each file and an
+// exit() on errors only ends that file.  A child's stdout and stderr are
+// captured and copied to ours in input order once all files before it
+// have been written, so the output does not depend on scheduling.
+//
+// jobs is the number of files compiled at once; 0 means one per online
+// processor.  Returns the number of files whose compilation failed.
+//
+
+typedef int (*compile_function)(char *filename);
+
+extern int batch_jobs;       // -j: workers in batch mode
+
+int compile_batch(int nfiles, char *files[], int jobs, compile_function compile);
+
+#endif
@@ -0,0 +1,137 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _COMPILATION_H_
+#define _COMPILATION_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: compilation.h
+//
+// The state of one compilation.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string>
+#include "tree.h"
+#include "seal-parse.h"
+#include "seal-tokens.h"
+
+//
+// CompilationContext
+//
+//   A context owns what the lexer and parser need for one source file:
+//   the input, the line the lexer is on, the count of lex and parse
+//   errors, the last token read (for error messages) and the root of the
+//   AST.  The AST nodes are allocated from the context's arena, which is
+//   ast_arena for as long as the context exists, and are freed with it.
+//   A context made with an arena of its caller's builds the AST there
+//   instead, and the nodes outlive the context.
+//
+//   The parser keeps its state on its own stack and the scanner's buffers
+//   are per thread and dropped at the end of each parse, so every thread
+//   can run its own compilations, one at a time.  The string tables are
+//   shared, so Symbols compare equal across threads.
+//
+//   parse() lexes and parses the whole input and returns the AST, or NULL
+//   if there were errors.
+//
+//   map_input() maps a regular input file into memory so that the scanner
+//   runs over the mapping in place instead of reading it through stdio
+//   into its own buffer.  It returns false, and the context keeps reading
+//   from the FILE, for stdin, pipes and anything else that cannot be
+//   mapped.  The file must not be truncated while it is being parsed.
+//   scan_buffer(buf, size) has the scanner run over size bytes of memory
+//   in place in the same way; the last two of them must be NULs, and the
+//   scanner changes the others while it runs.  buf stays the caller's.
+//
+//   The input may also be a token stream (see seal-tokens.h) saved by an
+//   earlier compilation.  read_tokens() checks for one, and if it finds
+//   one parse() reads the tokens from it instead of running the scanner.
+//   save_tokens() scans the whole input into a token stream in the file
+//   named like the input with "tok" appended (x.seal: x.sealtok), and
+//   then reads it back in the same way, so the tokens are saved even
+//   when the parse fails.  It returns false if the file cannot be made.
+//
+//   Instead of having parse() read it, the source may also be pushed to
+//   the context a chunk at a time, as it arrives: push(bytes, n) scans
+//   and parses as far as the bytes go and returns at once, without
+//   waiting for more, and push_end() says that the source is complete and
+//   returns the AST, or NULL, as parse() does.  push() returns false once
+//   the parse has failed; further bytes are ignored.  A token the chunk
+//   ends in, and everything after it, is held back and scanned again
+//   together with the next chunk, so chunks may split tokens, strings and
+//   comments anywhere.  Between pushes the scanner's buffers are free for
+//   other compilations on the same thread.  parse_stream() reads the input
+//   file this way, a read() at a time, so that a pipe is parsed as the
+//   writer sends it.
+//
+//   If on_decl is set, the parser calls it with each top-level Decl, and
+//   on_decl_data, as soon as the Decl is parsed, before the rest of the
+//   input is read: work on the early declarations can go on while the
+//   later ones are still arriving.
+//
+typedef void (*decl_function)(Decl decl, void *data);
+
+class CompilationContext {
+private:
+    AstArena *outer_arena;      // ast_arena before this context
+    size_t map_length;          // bytes mapped at map, whole pages, or 0
+                                // if map is the caller's
+    FILE *token_file;           // the stream written by save_tokens()
+    std::string pushed;         // pushed bytes not yet passed to the parser
+    size_t pushed_read;         // how many of them the scanner has read
+    bool pushed_end;            // push_end() has been called
+    int push_status;            // what the push parser last returned
+
+    void scan_pushed();
+
+    CompilationContext(const CompilationContext &);          // not copyable
+    CompilationContext &operator =(const CompilationContext &);
+public:
+    FILE *in;                   // the source being compiled
+    char *filename;             // its name, for error messages
+    int lineno;                 // the line the lexer is on
+    int errors;                 // lex and parse errors so far
+    int token;                  // the last token read
+    YYSTYPE token_value;        // and its semantic value
+    char *map;                  // the mapped input, or NULL if streaming
+    size_t map_size;            // its length plus the two NULs flex wants
+    TokenReader *tokens;        // the token stream read, or NULL to scan
+    Program root;               // the result of the parse
+    AstArena arena;             // the nodes of this compilation
+    decl_function on_decl;      // called with each top-level Decl parsed
+    void *on_decl_data;         // and passed to it
+    bool pushing;               // the source comes from push()
+    bool starved;               // the scanner has run out of pushed bytes
+    bool cutting;               // only scanning: stop at a lexical error
+    seal_yypstate *pstate;      // the push parser, once there is one
+
+    CompilationContext(FILE *in, char *filename, AstArena *nodes = NULL);
+    ~CompilationContext();
+    bool map_input();
+    void scan_buffer(char *buf, size_t size);
+    bool read_tokens();
+    bool save_tokens();
+    Program parse();
+    bool push(const char *bytes, size_t n);
+    Program push_end();
+    Program parse_stream();
+    size_t read_pushed(char *buf, size_t max);   // for the scanner
+};
+
+extern int keep_tokens;      // -k: save_tokens() for every input
+extern int stream_input;     // -i: parse_stream() every input
+
+extern int seal_yyparse(CompilationContext *ctx);
+extern int seal_yyscan(YYSTYPE *lvalp, CompilationContext *ctx);
+extern void seal_yyscan_reset();
+extern size_t seal_yyscan_unread();
+extern int seal_yypush(CompilationContext *ctx, int token, YYSTYPE *value);
+extern void seal_yypush_free(CompilationContext *ctx);
+
+#endif
@@ -30,6 +30,13 @@ extern int seal_yydebug;        // for the parser
        bool disable_reg_alloc;  // Don't do register allocation
 
        int cgen_optimize;       // optimize switch for code generator 
+       int batch_jobs;          // files compiled at once in batch mode
+       int check_jobs;          // threads checking function bodies
+       int keep_tokens;         // save each input's token stream
+       int stream_input;        // parse each input as it is read
+       int edit_session;        // the inputs are versions of one module
+       int ast_cache;           // load and save each input's typed AST
+       int run_program;         // run each input instead of dumping it
        char *out_filename;      // file name for generated code
        Memmgr cgen_Memmgr = GC_NOGC;      // enable/disable garbage collection
        Memmgr_Test cgen_Memmgr_Test = GC_NORMAL;  // normal/test GC
@@ -51,9 +58,16 @@ void handle_flags(int argc, char *argv[]) {
   cgen_debug = 0;
   cgen_optimize = 0;
   disable_reg_alloc = 0;
+  batch_jobs = 0;
+  check_jobs = 1;
+  keep_tokens = 0;
+  stream_input = 0;
+  edit_session = 0;
+  ast_cache = 0;
+  run_program = 0;
   
 
-  while ((c = getopt(argc, argv, "lpscvrOo:gtT")) != -1) {
+  while ((c = getopt(argc, argv, "lpscvrOo:gtTj:J:kieax")) != -1) {
     switch (c) {
 #ifdef DEBUG
     case 'l':
@@ -99,6 +113,27 @@ void handle_flags(int argc, char *argv[]) {
     case 'O':  // enable optimization
       cgen_optimize = 1;
       break;
+    case 'j':  // compile this many files at once (0: one per processor)
+      batch_jobs = atoi(optarg);
+      break;
+    case 'J':  // check function bodies on this many threads (0: one per processor)
+      check_jobs = atoi(optarg);
+      break;
+    case 'k':  // save the tokens of file.seal in file.sealtok
+      keep_tokens = 1;
+      break;
+    case 'i':  // push each input to the parser as it is read (not with -k)
+      stream_input = 1;
+      break;
+    case 'e':  // compile the inputs in turn in one session, report the last
+      edit_session = 1;
+      break;
+    case 'a':  // keep the typed AST of file.seal in file.sealast
+      ast_cache = 1;
+      break;
+    case 'x':  // compile to bytecode and run main, with -c listing the code
+      run_program = 1;
+      break;
     case '?':
       unknownopt = 1;
       break;
@@ -111,9 +146,9 @@ void handle_flags(int argc, char *argv[]) {
   if (unknownopt) {
       cerr << "usage: " << argv[0] << 
 #ifdef DEBUG
-	  " [-lvpscOgtTr -o outname] [input-files]\n";
+	  " [-lvpscOgtTrkieax -o outname -j jobs -J threads] [input-files]\n";
 #else
-      " [-OgtT -o outname] [input-files]\n";
+      " [-OgtTkieax -o outname -j jobs -J threads] [input-files]\n";
 #endif
       exit(1);
   }
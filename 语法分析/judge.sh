@@ -10,6 +10,14 @@ for filename in *.seal; do
     else 
         echo NOT passed
     fi
+    # and read from a pipe, which is neither mapped nor a token stream
+    cat $filename | ../parser /dev/stdin > tempfile
+    diff tempfile ../test-answer/$filename.out > /dev/null
+    if [ $? -eq 0 ]; then
+        echo "passed (piped)"
+    else
+        echo "NOT passed (piped)"
+    fi
 done
 rm -f tempfile
 cd ..
\ No newline at end of file
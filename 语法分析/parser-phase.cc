@@ -20,34 +20,43 @@
 #include "seal-expr.h"
 #include "utilities.h"  // for fatal_error
 #include "seal-parse.h"
+#include "batch.h"
+#include "compilation.h"
 
 
 //
 // These globals keep everything working.
 //
 FILE *token_file = stdin;		// we read from this file
-extern Program ast_root;	 // the AST produced by the parse
 
 extern int optind;  // used for option processing (man 3 getopt for more info)
 
-char *curr_filename = "<stdin>";
-FILE *fin;
+extern int semant_debug;       // -s: report AST memory
 
-extern int omerrs;             // a count of lex and parse errors
-
-extern int seal_yyparse();
 void handle_flags(int argc, char *argv[]);
 
-int main(int argc, char *argv[]) {
-    fin = fopen(argv[optind], "r");
+//
+// Parse one file and dump its AST.  Exits on errors.
+//
+static int compile(char *filename) {
+    FILE *fin = fopen(filename, "r");
 	    if (fin == NULL) {
-		cerr << "Could not open input file " << argv[optind] << endl;
+		cerr << "Could not open input file " << filename << endl;
 		exit(1);
 	}
-    curr_lineno = 1;
-    handle_flags(argc, argv);
-    seal_yyparse();
-    if (omerrs != 0) {
+    CompilationContext ctx(fin, filename);
+    Program ast_root;
+    if (stream_input)               // parse the input as it is read
+      ast_root = ctx.parse_stream();
+    else {
+      if (!ctx.read_tokens()) {     // a token stream saved with -k
+        ctx.map_input();            // falls back to reading fin
+        if (keep_tokens && !ctx.save_tokens())
+          cerr << "Could not save the tokens of " << filename << endl;
+      }
+      ast_root = ctx.parse();
+    }
+    if (ctx.errors != 0) {
 	    cerr << "Compilation halted due to lex and parse errors\n";
 	    exit(1);
     }
@@ -56,7 +65,15 @@ int main(int argc, char *argv[]) {
 	    exit(1);
     }
     ast_root->dump_with_types(cout,0);
+    if (semant_debug)
+        ast_arena->print_stats(cerr);
     fclose(fin);
     return 0;
 }
 
+int main(int argc, char *argv[]) {
+    handle_flags(argc, argv);
+    if (argc - optind > 1)
+        return compile_batch(argc - optind, argv + optind, batch_jobs, compile) ? 1 : 0;
+    return compile(argv[optind]);
+}
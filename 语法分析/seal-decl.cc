@@ -60,6 +60,10 @@ Decls append_Decls(Decls p1, Decls p2)
 {
    return new append_node<Decl>(p1, p2);
 }
+Decls add_Decls(Decls l, Decl e)
+{
+   return l->add(e);
+}
 
 
 VariableDecls nil_VariableDecls()
@@ -74,6 +78,10 @@ VariableDecls append_VariableDecls(VariableDecls p1, VariableDecls p2)
 {
    return new append_node<VariableDecl>(p1, p2);
 }
+VariableDecls add_VariableDecls(VariableDecls l, VariableDecl e)
+{
+   return l->add(e);
+}
 
 
 Variables nil_Variables()
@@ -88,6 +96,10 @@ Variables append_Variables(Variables p1, Variables p2)
 {
    return new append_node<Variable>(p1, p2);
 }
+Variables add_Variables(Variables l, Variable e)
+{
+   return l->add(e);
+}
 
 
 VariableDecl variableDecl(Variable v)
@@ -81,12 +81,15 @@ typedef Variables_class *Variables;
 Decls nil_Decls();
 Decls single_Decls(Decl);
 Decls append_Decls(Decls,Decls);
+Decls add_Decls(Decls,Decl);
 VariableDecls nil_VariableDecls();
 VariableDecls single_VariableDecls(VariableDecl);
 VariableDecls append_VariableDecls(VariableDecls,VariableDecls);
+VariableDecls add_VariableDecls(VariableDecls,VariableDecl);
 Variables nil_Variables();
 Variables single_Variables(Variable);
 Variables append_Variables(Variables,Variables);
+Variables add_Variables(Variables,Variable);
 
 VariableDecl variableDecl(Variable);
 Variable variable(Symbol,Symbol);
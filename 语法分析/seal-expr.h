@@ -438,26 +438,31 @@ typedef Actuals_class *Actuals;
 Exprs nil_Exprs();
 Exprs single_Exprs(Expr);
 Exprs append_Exprs(Exprs,Exprs);
+Exprs add_Exprs(Exprs,Expr);
 
 
 LValues nil_LValues();
 LValues single_LValues(LValue);
 LValues append_LValues(LValues,LValues);
+LValues add_LValues(LValues,LValue);
 
 
 Calls nil_Calls();
 Calls single_Calls(Call);
 Calls append_Calls(Calls,Calls);
+Calls add_Calls(Calls,Call);
 
 
 Actuals nil_Actuals();
 Actuals single_Actuals(Actual);
 Actuals append_Actuals(Actuals,Actuals);
+Actuals add_Actuals(Actuals,Actual);
 
 
 Constants nil_Constants();
 Constants single_Constants(Constant);
 Constants append_Constants(Constants,Constants);
+Constants add_Constants(Constants,Constant);
 
 
 Expr assign(Symbol, Expr);
@@ -203,12 +203,12 @@ typedef size_t yy_size_t;
 #endif
 
 /* %if-not-reentrant */
-extern yy_size_t yyleng;
+extern thread_local yy_size_t yyleng;
 /* %endif */
 
 /* %if-c-only */
 /* %if-not-reentrant */
-extern FILE *yyin, *yyout;
+extern thread_local FILE *yyin, *yyout;
 /* %endif */
 /* %endif */
 
@@ -310,9 +310,9 @@ struct yy_buffer_state
 /* %if-not-reentrant */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 /* %endif */
 /* %ok-for-header */
 
@@ -339,19 +339,19 @@ static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 /* %not-for-header */
 
 /* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static yy_size_t yy_n_chars;		/* number of characters read into yy_ch_buf */
-yy_size_t yyleng;
+static thread_local char yy_hold_char;
+static thread_local yy_size_t yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local yy_size_t yyleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow yywrap()'s to do buffer switches
  * instead of setting up a fresh yyin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 /* %ok-for-header */
 
 /* %endif */
@@ -414,15 +414,15 @@ void yyfree (void *  );
 
 typedef unsigned char YY_CHAR;
 
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
+thread_local FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int yylineno;
+extern thread_local int yylineno;
 
-int yylineno = 1;
+thread_local int yylineno = 1;
 
-extern char *yytext;
+extern thread_local char *yytext;
 #define yytext_ptr yytext
 
 /* %if-c-only Standard (non-C++) definition */
@@ -628,8 +628,8 @@ static yyconst flex_int16_t yy_chk[277] =
       145,  145,  145,  145,  145,  145
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
+static thread_local yy_state_type yy_last_accepting_state;
+static thread_local char *yy_last_accepting_cpos;
 
 extern int yy_flex_debug;
 int yy_flex_debug = 1;
@@ -652,7 +652,7 @@ static yyconst flex_int16_t yy_rule_linenum[68] =
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
+thread_local char *yytext;
 #line 1 "seal.flex"
 /*
 *  The scanner definition for seal.
@@ -670,40 +670,63 @@ char *yytext;
 #include <stdint.h>
 #include <stdlib.h>
 
-/* The compiler assumes these identifiers. */
-#define yylval seal_yylval
-#define yylex  seal_yylex
+#include <compilation.h>
+#include <seal-skip.h>
+
+/*
+ * The scanner is called by the parser as seal_yyscan(&yylval, ctx).  It
+ * returns the token's value through lvalp and counts lines in the
+ * compilation context; its buffers are per thread (see seal_yyscan_reset
+ * below).  If the context has mapped its input, the scanner runs over the
+ * mapping itself; otherwise it reads the input through YY_INPUT.
+ */
+#define YY_DECL int seal_yyscan(YYSTYPE *lvalp, CompilationContext *ctx)
+#define seal_yylval (*lvalp)
+#define curr_lineno (ctx->lineno)
+
+/* A scan that only looks for where the declarations end (ctx->cutting)
+ * does not exit at a lexical error but stops there, as if at the end of
+ * the input; parsing the rest reports the error, if it gets that far.
+ */
+#define STOP_IF_CUTTING() \
+	if (ctx->cutting) { ctx->errors++; yyterminate(); }
 
 /* Max size of string constants */
 #define MAX_STR_CONST 256
 #define YY_NO_UNPUT   /* keep g++ happy */
 
-extern FILE *fin; /* we read from this file */
-
-/* define YY_INPUT so we read from the FILE fin:
+/* define YY_INPUT so we read from the context's input file:
  * This change makes it possible to use this scanner in
- * the seal compiler.
+ * the seal compiler.  Bytes pushed to the context are read from it.
  */
 #undef YY_INPUT
 #define YY_INPUT(buf,result,max_size) \
-	if ( (result = fread( (char*)buf, sizeof(char), max_size, fin)) < 0) \
+	if ( yyctx->pushing ) \
+		result = yyctx->read_pushed( (char*)buf, max_size ); \
+	else if ( (result = fread( (char*)buf, sizeof(char), max_size, yyin)) < 0) \
 		YY_FATAL_ERROR( "read() in flex scanner failed");
 
-char string_buf[MAX_STR_CONST]; /* to assemble string constants */
-char *string_buf_ptr;
+static thread_local CompilationContext *yyctx;	/* the one being scanned */
 
-extern int curr_lineno;
-extern int verbose_flag;
+/* Once the scanner has run out of pushed bytes, what it matches may go on
+ * in the next chunk, and is scanned again then: run no more actions, not
+ * even those that report errors.
+ */
+#define YY_USER_ACTION \
+	if ( yyctx->starved ) \
+		return 0;
+static thread_local char string_buf[MAX_STR_CONST]; /* to assemble string constants */
+static thread_local char *string_buf_ptr;
 
-extern YYSTYPE seal_yylval;
+extern int verbose_flag;
 
 /*
  *  Add Your own definitions here
  */
 
-char string_const[MAX_STR_CONST + 10];
-int string_const_len;
-bool str_contain_null_char;
+static thread_local char string_const[MAX_STR_CONST + 10];
+static thread_local int string_const_len;
+static thread_local bool str_contain_null_char;
 
 /*
 * Define names for regular expressions here.
@@ -956,6 +979,10 @@ YY_DECL
     
 /* %% [7.0] user's declarations go here */
 #line 69 "seal.flex"
+	yyin = ctx->in;
+	yyctx = ctx;
+	if (ctx->map != NULL && YY_CURRENT_BUFFER == NULL)
+		yy_scan_buffer(ctx->map, ctx->map_size);  /* scan it in place */
 
 
 #line 962 "seal-lex.cc"
@@ -1002,6 +1029,13 @@ YY_DECL
 		/* Support of yytext. */
 		*yy_cp = (yy_hold_char);
 
+		/* Blanks and comments are skipped in bulk, so that the DFA
+		 * only starts on tokens (see seal-skip.h).  Not when tracing
+		 * rules with -l, which would then not show them.
+		 */
+		if ( (yy_start) == 1 + 2 * INITIAL && ! yy_flex_debug )
+			yy_cp = seal_skip(yy_cp, &curr_lineno);
+
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
@@ -1121,6 +1155,8 @@ YY_RULE_SETUP
 case YY_STATE_EOF(BLOCK_COMMENT):
 #line 85 "seal.flex"
 { 
+	if (ctx->starved) yyterminate();	/* more is still to be pushed */
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": Comment meets an EOF.\n";
   exit(-1);
 }
@@ -1134,6 +1170,7 @@ case 10:
 YY_RULE_SETUP
 #line 90 "seal.flex"
 {
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": Unmatched */.\n";
   exit(-1);
 }
@@ -1353,6 +1390,8 @@ YY_RULE_SETUP
 case YY_STATE_EOF(QUOTE_STRING):
 #line 171 "seal.flex"
 {
+	if (ctx->starved) yyterminate();
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": String constant meets an EOF.\n";
   exit(-1);
 }
@@ -1362,6 +1401,7 @@ YY_RULE_SETUP
 #line 176 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1385,6 +1425,7 @@ YY_RULE_SETUP
 #line 196 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1402,6 +1443,7 @@ YY_RULE_SETUP
 #line 210 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1424,6 +1466,7 @@ YY_RULE_SETUP
 #line 228 "seal.flex"
 { 
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1436,6 +1479,7 @@ case 52:
 YY_RULE_SETUP
 #line 236 "seal.flex"
 {
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 }
@@ -1445,6 +1489,7 @@ YY_RULE_SETUP
 #line 241 "seal.flex"
 { 
 	if (string_const_len > 0 && str_contain_null_char) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String contains a '\0'.\n";
     exit(-1);
 	}
@@ -1457,6 +1502,7 @@ YY_RULE_SETUP
 #line 250 "seal.flex"
 { 
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1478,6 +1524,7 @@ YY_RULE_SETUP
 #line 264 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1490,6 +1537,7 @@ YY_RULE_SETUP
 #line 273 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1501,6 +1549,7 @@ YY_RULE_SETUP
 #line 281 "seal.flex"
 {
 	if (string_const_len >= MAX_STR_CONST) {
+		STOP_IF_CUTTING();
 		cerr << curr_lineno << ": String length is more than 256.\n";
     exit(-1);
 	} 
@@ -1511,6 +1560,8 @@ YY_RULE_SETUP
 case YY_STATE_EOF(REVERSE_STRING):
 #line 290 "seal.flex"
 {
+	if (ctx->starved) yyterminate();
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": String constant meets an EOF.\n";
     exit(-1);
 }
@@ -1590,6 +1641,7 @@ case 65:
 YY_RULE_SETUP
 #line 349 "seal.flex"
 {
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": Illegal Type name " << yytext << ".\n";
     exit(-1);
 }
@@ -1598,6 +1650,7 @@ case 66:
 YY_RULE_SETUP
 #line 354 "seal.flex"
 {
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": Illegal Identifier name " << yytext << ".\n";
     exit(-1);
 }
@@ -1609,6 +1662,7 @@ case 67:
 YY_RULE_SETUP
 #line 363 "seal.flex"
 {
+	STOP_IF_CUTTING();
 	cerr << curr_lineno << ": Illegal character " << yytext << ".\n";
     exit(-1);
 }
@@ -2745,5 +2799,28 @@ void yyfree (void * ptr )
 
 #line 368 "seal.flex"
 
+/*
+ * Drop the buffers and start condition of the last compilation on this
+ * thread, so that the next one starts reading its own input afresh.  The
+ * scanner NUL-terminates the last token in its buffer; a buffer scanned
+ * in place gets the byte back, as the scan may have stopped early.
+ */
+void seal_yyscan_reset()
+{
+	if (YY_CURRENT_BUFFER != NULL && (yy_c_buf_p) != NULL)
+		*(yy_c_buf_p) = (yy_hold_char);
+	yylex_destroy();
+}
+
+/* The number of bytes the scanner has read into its buffer but not yet
+ * scanned: those after the token it returned last.
+ */
+size_t seal_yyscan_unread()
+{
+	if (YY_CURRENT_BUFFER == NULL)
+		return 0;
+	return (yy_n_chars) - ((yy_c_buf_p) - YY_CURRENT_BUFFER_LVALUE->yy_ch_buf);
+}
+
 
 
@@ -0,0 +1,40 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SEAL_SKIP_H_
+#define _SEAL_SKIP_H_
+
+//
+// The scanner's fast path over blanks and comments.
+//
+// seal_skip(p, &lines) returns the first byte at or after p that is not
+// a blank (space, \t, \n, \v, \f or \r) and not inside a // or /* */
+// comment, and adds the newlines it passed to lines.  It runs over
+// 16 or 32 bytes at a time with SSE2 or AVX2, whichever the processor
+// has, and a byte at a time elsewhere.
+//
+// p must point into a NUL-terminated buffer, as flex's buffers are.  The
+// scan stops at a NUL; a comment that is not complete before the NUL is
+// not skipped, so that the scanner's own rules see it and can refill
+// the buffer.  Whole aligned blocks are read, so bytes past the NUL in
+// the same block may be read, but are never used.
+//
+
+char *seal_skip_bulk(char *p, int *lines);
+
+// Most tokens follow at most one space: step over it here, and go on to
+// the bulk scan only if more blanks or a comment may follow.
+inline char *seal_skip(char *p, int *lines)
+{
+    if (*p == ' ')
+        p++;
+    char c = *p;
+    if (c == ' ' || (c >= '\t' && c <= '\r') || c == '/')
+        return seal_skip_bulk(p, lines);
+    return p;
+}
+
+#endif
@@ -120,6 +120,10 @@ Stmts append_Stmts(Stmts p1, Stmts p2)
 {
    return new append_node<Stmt>(p1, p2);
 }
+Stmts add_Stmts(Stmts l, Stmt e)
+{
+   return l->add(e);
+}
 
 
 Program program(Decls a1)
@@ -140,41 +140,49 @@ typedef Stmts_class *Stmts;
 StmtBlocks nil_StmtBlocks();
 StmtBlocks single_StmtBlocks(StmtBlock);
 StmtBlocks append_StmtBlocks(StmtBlocks,StmtBlocks);
+StmtBlocks add_StmtBlocks(StmtBlocks,StmtBlock);
 
 
 Stmts nil_Stmts();
 Stmts single_Stmts(Stmt);
 Stmts append_Stmts(Stmts,Stmts);
+Stmts add_Stmts(Stmts,Stmt);
 
 
 IfStmts nil_IfStmts();
 IfStmts single_IfStmts(IfStmt);
 IfStmts append_IfStmts(IfStmts,IfStmts);
+IfStmts add_IfStmts(IfStmts,IfStmt);
 
 
 WhileStmts nil_WhileStmts();
 WhileStmts single_WhileStmts(WhileStmt);
 WhileStmts append_WhileStmts(WhileStmts,WhileStmts);
+WhileStmts add_WhileStmts(WhileStmts,WhileStmt);
 
 
 ForStmts nil_ForStmts();
 ForStmts single_ForStmts(ForStmt);
 ForStmts append_ForStmts(ForStmts,ForStmts);
+ForStmts add_ForStmts(ForStmts,ForStmt);
 
 
 ReturnStmts nil_ReturnStmts();
 ReturnStmts single_ReturnStmts(ReturnStmt);
 ReturnStmts append_ReturnStmts(ReturnStmts,ReturnStmts);
+ReturnStmts add_ReturnStmts(ReturnStmts,ReturnStmt);
 
 
 ContinueStmts nil_ContinueStmts();
 ContinueStmts single_ContinueStmts(ContinueStmt);
 ContinueStmts append_ContinueStmts(ContinueStmts,ContinueStmts);
+ContinueStmts add_ContinueStmts(ContinueStmts,ContinueStmt);
 
 
 BreakStmts nil_BreakStmts();
 BreakStmts single_BreakStmts(BreakStmt);
 BreakStmts append_BreakStmts(BreakStmts,BreakStmts);
+BreakStmts add_BreakStmts(BreakStmts,BreakStmt);
 
 Program program(Decls);
 StmtBlock stmtBlock(VariableDecls, Stmts);
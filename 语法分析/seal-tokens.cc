@@ -0,0 +1,222 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-tokens.cc
+//
+// Writes and reads binary token streams.  See seal-tokens.h for the
+// format.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include "seal-tokens.h"
+#include "stringtab.h"
+
+enum { ID_TABLE, INT_TABLE, FLOAT_TABLE, STRING_TABLE };
+
+//
+// Reading the magic cannot be undone on a pipe or a terminal, which are
+// taken to be source without reading them; token streams are files.
+//
+bool is_token_stream(FILE *in)
+{
+    char magic[8];
+    long start = ftell(in);
+
+    if (start < 0 || fseek(in, start, SEEK_SET) != 0)
+        return false;
+    if (fread(magic, 1, 8, in) == 8 && memcmp(magic, TOKEN_STREAM_MAGIC, 8) == 0)
+        return true;
+    clearerr(in);
+    if (fseek(in, start, SEEK_SET) != 0) {
+        perror("is_token_stream");
+        exit(1);
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// TokenWriter
+//
+///////////////////////////////////////////////////////////////////////////
+
+TokenWriter::TokenWriter(FILE *out_)
+    : out(out_), lineno(1), nids(0), nints(0), nfloats(0), nstrings(0)
+{
+    fwrite(TOKEN_STREAM_MAGIC, 1, 8, out);
+}
+
+void TokenWriter::put(unsigned v)
+{
+    while (v >= 0x80) {
+        putc((v & 0x7f) | 0x80, out);
+        v >>= 7;
+    }
+    putc(v, out);
+}
+
+//
+// A symbol is written as its index in the stream's table; the first time
+// it is written its string follows.  index maps the symbol's index in
+// the string table to its index in the stream, or -1.
+//
+void TokenWriter::put_symbol(std::vector<int> &index, int &count, Symbol sym)
+{
+    int i = sym->get_index();
+    if (i >= (int) index.size())
+        index.resize(2 * i + 16, -1);
+    if (index[i] >= 0) {
+        put(index[i]);
+        return;
+    }
+    index[i] = count++;
+    put(index[i]);
+    put(sym->get_len());
+    fwrite(sym->get_string(), 1, sym->get_len(), out);
+}
+
+void TokenWriter::write(int token, YYSTYPE value, int line)
+{
+    put(token);
+    put(line - lineno);
+    lineno = line;
+
+    switch (token) {
+    case OBJECTID:
+    case TYPEID:
+        put_symbol(ids, nids, value.symbol);
+        break;
+    case CONST_INT:
+        put_symbol(ints, nints, value.symbol);
+        break;
+    case CONST_FLOAT:
+        put_symbol(floats, nfloats, value.symbol);
+        break;
+    case CONST_STRING:
+        put_symbol(strings, nstrings, value.symbol);
+        break;
+    case CONST_BOOL:
+        put(value.boolean ? 1 : 0);
+        break;
+    case ERROR: {
+        int len = strlen(value.error_msg);
+        put(len);
+        fwrite(value.error_msg, 1, len, out);
+        break;
+    }
+    }
+}
+
+void TokenWriter::finish(int line)
+{
+    put(0);
+    put(line - lineno);
+    fflush(out);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// TokenReader
+//
+//   A stream that ends early or refers to a string it has not defined is
+//   reported and ends the compiler, as errors in the source do.
+//
+///////////////////////////////////////////////////////////////////////////
+
+TokenReader::TokenReader(FILE *in_, char *filename_)
+    : in(in_), filename(filename_), lineno(1)
+{
+}
+
+static void corrupt(char *filename)
+{
+    cerr << filename << ": corrupt token stream\n";
+    exit(1);
+}
+
+unsigned TokenReader::get()
+{
+    unsigned v = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        int c = getc(in);
+        if (c == EOF)
+            corrupt(filename);
+        v |= (unsigned) (c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return v;
+    }
+    corrupt(filename);
+    return 0;
+}
+
+// a string of the stream, NUL terminated; the caller owns it
+char *TokenReader::get_string(int *len)
+{
+    *len = get();
+    char *s = new char[*len + 1];
+    if ((int) fread(s, 1, *len, in) != *len)
+        corrupt(filename);
+    s[*len] = '\0';
+    return s;
+}
+
+Symbol TokenReader::get_symbol(std::vector<Symbol> &table, int kind)
+{
+    unsigned i = get();
+    if (i < table.size())
+        return table[i];
+    if (i > table.size())
+        corrupt(filename);
+
+    int len;
+    char *s = get_string(&len);
+    Symbol sym;
+    switch (kind) {
+    case ID_TABLE:     sym = idtable.add_string(s, len); break;
+    case INT_TABLE:    sym = inttable.add_string(s, len); break;
+    case FLOAT_TABLE:  sym = floattable.add_string(s, len); break;
+    default:           sym = stringtable.add_string(s, len); break;
+    }
+    delete[] s;
+    table.push_back(sym);
+    return sym;
+}
+
+int TokenReader::read(YYSTYPE *value, int *line)
+{
+    int token = get();
+    lineno += get();
+    *line = lineno;
+
+    switch (token) {
+    case OBJECTID:
+    case TYPEID:
+        value->symbol = get_symbol(ids, ID_TABLE);
+        break;
+    case CONST_INT:
+        value->symbol = get_symbol(ints, INT_TABLE);
+        break;
+    case CONST_FLOAT:
+        value->symbol = get_symbol(floats, FLOAT_TABLE);
+        break;
+    case CONST_STRING:
+        value->symbol = get_symbol(strings, STRING_TABLE);
+        break;
+    case CONST_BOOL:
+        value->boolean = get() != 0;
+        break;
+    case ERROR: {
+        int len;
+        value->error_msg = get_string(&len);   // kept for the parse
+        break;
+    }
+    }
+    return token;
+}
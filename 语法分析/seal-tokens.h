@@ -0,0 +1,86 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SEAL_TOKENS_H_
+#define _SEAL_TOKENS_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-tokens.h
+//
+// Binary token streams: the output of the lexer saved to a file, so that
+// the parser can be run on it again and again without lexing.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <vector>
+#include "seal-parse.h"
+
+//
+// A stream starts with the 8 bytes of TOKEN_STREAM_MAGIC.  Each token
+// follows as
+//
+//      varint  token code, as in seal-parse.h (0 ends the stream)
+//      varint  lines since the previous token
+//      value   for tokens that have one
+//
+// Varints are unsigned LEB128: seven bits a byte, low bits first, the
+// top bit set on all bytes but the last.  The values are
+//
+//      OBJECTID, TYPEID    varint index into the stream's identifiers
+//      CONST_INT           varint index into its integers
+//      CONST_FLOAT         varint index into its floats
+//      CONST_STRING        varint index into its strings
+//      CONST_BOOL          varint 0 or 1
+//      ERROR               varint length, then the message
+//
+// Each of the four tables starts empty.  An index equal to the number of
+// entries in its table so far adds an entry: the varint length and the
+// characters of the string follow.  So every string is written once,
+// where it is first used.
+//
+#define TOKEN_STREAM_MAGIC "SEALTOK1"
+
+class TokenWriter {
+private:
+    FILE *out;
+    int lineno;                         // line of the last token written
+    std::vector<int> ids, ints, floats, strings; // stream index of each
+                                        // table entry, by its own index
+    int nids, nints, nfloats, nstrings; // entries written to each table
+
+    void put(unsigned v);
+    void put_symbol(std::vector<int> &index, int &count, Symbol sym);
+public:
+    TokenWriter(FILE *out);
+    void write(int token, YYSTYPE value, int lineno);
+    void finish(int lineno);            // write the end of the stream
+};
+
+class TokenReader {
+private:
+    FILE *in;
+    char *filename;                     // for error messages
+    int lineno;
+    std::vector<Symbol> ids, ints, floats, strings;
+
+    unsigned get();
+    char *get_string(int *len);
+    Symbol get_symbol(std::vector<Symbol> &table, int kind);
+public:
+    // in must be positioned after the magic
+    TokenReader(FILE *in, char *filename);
+    // the next token, its value and line; 0 at the end of the stream
+    int read(YYSTYPE *value, int *lineno);
+};
+
+// does in start with a token stream?  Leaves in positioned after the
+// magic if so and where it was otherwise.  Only a file that can seek is
+// looked at; a pipe is never a token stream.
+bool is_token_stream(FILE *in);
+
+#endif
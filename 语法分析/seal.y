@@ -11,13 +11,13 @@
   #include "stringtab.h"
   #include "utilities.h"
 
-  extern char *curr_filename;
+  #include "compilation.h"
+
   /* Locations */
   #define YYLTYPE int              /* the type of locations */
-  #define seal_yylloc curr_lineno  /* use the curr_lineno from the lexer
-  for the location of tokens */
+  #undef YYLTYPE_IS_TRIVIAL        /* not the struct from seal-parse.h */
     
-    extern int node_lineno;          /* set before constructing a tree node
+    extern thread_local int node_lineno; /* set before constructing a tree node
     to whatever you want the line number
     for the tree node to be */
       
@@ -74,17 +74,24 @@
     
     
     
-    void yyerror(char *s);        /*  defined below; called for each parse error */
-    extern int yylex();           /*  the entry point to the lexer  */
+    /* defined below; called for each parse error */
+    void yyerror(YYLTYPE *llocp, CompilationContext *ctx, const char *s);
+    /* defined below; reads the next token for the parser */
+    static int yylex(YYSTYPE *lvalp, YYLTYPE *llocp, CompilationContext *ctx);
     
     /************************************************************************/
     /*                DONT CHANGE ANYTHING IN THIS SECTION                  */
-    
-    Program ast_root;	      /* the result of the parse  */
-    //Decls parse_results;        /* for use in semantic analysis */
-    int omerrs = 0;               /* number of errors in lexing and parsing */
     %}
     
+    /* The parser is pure: everything one parse needs lives in ctx.  It can
+    pull its tokens from yylex (seal_yyparse) or have them pushed to it one
+    at a time (seal_yypush below). */
+    %define api.pure full
+    %define api.push-pull both
+    %parse-param {CompilationContext *ctx}
+    %lex-param {CompilationContext *ctx}
+    %locations
+    
     /* A union of all the types that can be the result of parsing actions. */
     %union {
       Boolean boolean;
@@ -144,41 +151,362 @@
     
     /* Declare types for the grammar's non-terminals. */
     %type <program> program
-    %type <decls> decl_list
     %type <decl> decl
+    %type <decls> decl_list
+    %type <variableDecl> variableDecl
+    %type <variableDecls> variableDecl_list
+    %type <variable> variable
+    %type <variables> variable_list
+    %type <callDecl> callDecl
+    %type <stmtBlock> stmtBlock
+    %type <stmt> stmt
+    %type <stmts> stmt_list
+    %type <ifStmt> ifStmt
+    %type <whileStmt> whileStmt
+    %type <forStmt> forStmt
+    %type <breakStmt> breakStmt
+    %type <continueStmt> continueStmt
+    %type <returnStmt> returnStmt
+    %type <expr> expr
+    %type <call> call
+    %type <actual> actual
+    %type <actuals> actual_list
 
-	// Add more here
-
-    /* Precedence declarations go here. */
-	  %nonassoc '='
-
-	// Add more here
-    
+    /* Precedence declarations go here.  They settle every choice between
+    shifting and reducing in the expression rules, so the tables must have
+    no conflicts at all: bison fails if a change to the grammar adds one. */
+    %expect 0
+    %nonassoc '='
+    %right OR
+    %right AND
+    %nonassoc EQUAL NE
+    %nonassoc '<' '>' LE GE
+    %left '+' '-'
+    %left '*' '/' '%'
+    %right '!' UMINUS
+    %left '~' '&' '|' '^'
 %%
+program
+			: decl_list {
+					@$ = @1;
+					ctx->root = program($1); 
+				}
+			;
+decl
+			: variableDecl {
+					$$ = $1;
+				}
+			| callDecl {
+					$$ = $1;
+				}
+			;
+/* The list rules are left recursive, so the parser's stack stays as
+   shallow however long a list gets, and they grow each list in place with
+   add_ (see tree.h) instead of chaining append_nodes. */
+decl_list
+			: decl { 
+					$$ = single_Decls($1);
+					if (ctx->on_decl != NULL)
+						ctx->on_decl($1, ctx->on_decl_data);
+				}
+			| decl_list decl { 
+					$$ = add_Decls($1, $2); 
+					if (ctx->on_decl != NULL)
+						ctx->on_decl($2, ctx->on_decl_data);
+				}
+			;
+variableDecl
+			: variable ';' {
+					$$ = variableDecl($1);
+				}
+			;
+variableDecl_list
+			: variableDecl { 
+					$$ = single_VariableDecls($1);
+				}
+			| variableDecl_list variableDecl { 
+					$$ = add_VariableDecls($1, $2); 
+				}
+			;
+variable
+			: TYPEID OBJECTID {
+					$$ = variable($1, $2);
+				}
+			;
+variable_list
+			: variable { 
+					$$ = single_Variables($1);
+				}
+			| variable_list ',' variable {
+					$$ = add_Variables($1, $3);
+				}
+			;
+callDecl
+			: TYPEID FUNC OBJECTID '(' variable_list ')' stmtBlock {
+					$$ = callDecl($3, $5, $1, $7);
+				}
+			| TYPEID FUNC OBJECTID '(' ')' stmtBlock {
+					$$ = callDecl($3, nil_Variables(), $1, $6);
+				}
+			;
+stmtBlock
+			: '{' variableDecl_list stmt_list '}' {
+					$$ = stmtBlock($2, $3);
+				}
+			| '{' stmt_list '}' {
+					$$ = stmtBlock(nil_VariableDecls(), $2);
+				}
+			| '{' variableDecl_list '}' {
+					$$ = stmtBlock($2, nil_Stmts());
+				}
+			| '{' '}' {
+					$$ = stmtBlock(nil_VariableDecls(), nil_Stmts());
+				}
+			;
+stmt
+			: ';' {
+					$$ = no_expr();
+				}
+			| expr ';' {
+					$$ = $1;
+				}
+			| ifStmt {
+					$$ = $1;
+				}
+			| whileStmt {
+					$$ = $1;
+				}
+			| forStmt {
+					$$ = $1;
+				}
+			| breakStmt {
+					$$ = $1;
+				}
+			| continueStmt {
+					$$ = $1;
+				}
+			| returnStmt {
+					$$ = $1;
+				}
+			| stmtBlock {
+					$$ = $1;
+				}
+			;
+stmt_list
+			: stmt { 
+					$$ = single_Stmts($1);
+				}
+			| stmt_list stmt {
+					$$ = add_Stmts($1, $2);
+				}
+			;
+ifStmt
+			: IF expr stmtBlock {
+					$$ = ifstmt($2, $3, stmtBlock(nil_VariableDecls(), nil_Stmts()));
+				}
+			| IF expr stmtBlock ELSE stmtBlock {
+					$$ = ifstmt($2, $3, $5);
+				}
+			;
+whileStmt
+			: WHILE expr stmtBlock {
+					$$ = whilestmt($2, $3);
+				}
+			;
+forStmt
+			: FOR expr ';' expr ';' expr stmtBlock {
+					$$ = forstmt($2, $4, $6, $7);
+				}
+			| FOR ';' expr ';' expr stmtBlock {
+					$$ = forstmt(no_expr(), $3, $5, $6);
+				}
+			| FOR expr ';' ';' expr stmtBlock {
+					$$ = forstmt($2, no_expr(), $5, $6);
+				}
+			| FOR expr ';' expr ';' stmtBlock {
+					$$ = forstmt($2, $4, no_expr(), $6);
+				}
+			| FOR ';' ';' expr stmtBlock {
+					$$ = forstmt(no_expr(), no_expr(), $4, $5);
+				}
+			| FOR ';' expr ';' stmtBlock {
+					$$ = forstmt(no_expr(), $3, no_expr(), $5);
+				}
+			| FOR expr ';' ';' stmtBlock {
+					$$ = forstmt($2, no_expr(), no_expr(), $5);
+				}
+			| FOR ';' ';' stmtBlock {
+					$$ = forstmt(no_expr(), no_expr(), no_expr(), $4);
+				}
+			;
+breakStmt
+			: BREAK ';' {
+					$$ = breakstmt();
+				}
+			;
+continueStmt
+			: CONTINUE ';' {
+					$$ = continuestmt();
+				}
+			;
+returnStmt
+			: RETURN expr ';' {
+					$$ = returnstmt($2);
+				}
+			| RETURN ';' {
+					$$ = returnstmt(no_expr());
+				}
+			;
+expr
+			: OBJECTID '=' expr {
+					$$ = assign($1, $3);
+				}
+			| CONST_INT {
+					$$ = const_int($1);
+				}
+			| CONST_STRING {
+					$$ = const_string($1);
+				}
+			| CONST_FLOAT {
+					$$ = const_float($1);
+				}
+			| CONST_BOOL {
+					$$ = const_bool($1);
+				}
+			| OBJECTID {
+					$$ = object($1);
+				}
+			| call {
+					$$ = $1;
+				}
+			| '(' expr ')' {
+					$$ = $2;
+				}
+			| expr '+' expr {
+					$$ = add($1, $3);
+				}
+			| expr '-' expr {
+					$$ = minus($1, $3);
+				}
+			| expr '*' expr {
+					$$ = multi($1, $3);
+				}
+			| expr '/' expr {
+					$$ = divide($1, $3);
+				}
+			| expr '%' expr {
+					$$ = mod($1, $3);
+				}
+			| '-' expr %prec UMINUS {
+					$$ = neg($2);
+				}
+			| expr '<' expr {
+					$$ = lt($1, $3);
+				}
+			| expr LE expr {
+					$$ = le($1, $3);
+				}
+			| expr EQUAL expr {
+					$$ = equ($1, $3);
+				}
+			| expr NE expr {
+					$$ = neq($1, $3);
+				}
+			| expr GE expr {
+					$$ = ge($1, $3);
+				}
+			| expr '>' expr {
+					$$ = gt($1, $3);
+				}
+			| expr AND expr {
+					$$ = and_($1, $3);
+				}
+			| expr OR expr {
+					$$ = or_($1, $3);
+				}
+			| '!' expr {
+					$$ = not_($2);
+				}
+			| '~' expr {
+					$$ = bitnot($2);
+				}
+			| expr '&' expr {
+					$$ = bitand_($1, $3);
+				}
+			| expr '|' expr {
+					$$ = bitor_($1, $3);
+				}
+			| expr '^' expr {
+					$$ = xor_($1, $3);
+				}
+			;
+call
+			: OBJECTID '(' actual_list ')' {
+					$$ = call($1, $3);
+				}
+			| OBJECTID '(' ')' {
+					$$ = call($1, nil_Actuals());
+				}
+			;
+actual
+			: expr {
+					$$ = actual($1);
+				}
+			;
+actual_list
+			: actual { 
+					$$ = single_Actuals($1);
+				}
+			| actual_list ',' actual { 
+					$$ = add_Actuals($1, $3); 
+				}
+			;
 
-    /* Save the root of the abstract syntax tree in a global variable. */
-	/* Add more rules here */
-    program		: decl_list {
-        @$ = @1;
-        ast_root = program($1); 
-      }
-      ;
-
-    // add more syntax rules here
-    
     /* end of grammar */
 %%
     
+    /* Read the next token, from the scanner or a saved token stream, and
+       remember it for error messages. */
+    static int yylex(YYSTYPE *lvalp, YYLTYPE *llocp, CompilationContext *ctx)
+    {
+      int token;
+      if (ctx->tokens != NULL)
+        token = ctx->tokens->read(lvalp, &ctx->lineno);
+      else
+        token = seal_yyscan(lvalp, ctx);
+      *llocp = ctx->lineno;       /* the line of the token */
+      ctx->token = token;
+      ctx->token_value = *lvalp;
+      return token;
+    }
+    
+    /* Push one token, read by the caller, to the parser of ctx.  Returns
+       YYPUSH_MORE while the parser wants more tokens, 0 when it has
+       accepted the program and 1 when it has given up. */
+    int seal_yypush(CompilationContext *ctx, int token, YYSTYPE *value)
+    {
+      if (ctx->pstate == NULL)
+        ctx->pstate = seal_yypstate_new();
+      YYLTYPE loc = ctx->lineno;
+      ctx->token = token;
+      ctx->token_value = *value;
+      return seal_yypush_parse(ctx->pstate, token, value, &loc, ctx);
+    }
+
+    void seal_yypush_free(CompilationContext *ctx)
+    {
+      seal_yypstate_delete(ctx->pstate);
+      ctx->pstate = NULL;
+    }
+    
     /* This function is called automatically when Bison detects a parse error. */
-    void yyerror(char *s)
+    void yyerror(YYLTYPE *llocp, CompilationContext *ctx, const char *s)
     {
-      extern int curr_lineno;
-      
-      cerr << "\"" << curr_filename << "\", line " << curr_lineno << ": " \
+      cerr << "\"" << ctx->filename << "\", line " << ctx->lineno << ": " \
       << s << " at or near ";
-      print_seal_token(yychar);
+      print_seal_token(ctx->token, ctx->token_value);
       cerr << endl;
-      omerrs++;
+      ctx->errors++;
       
-      if(omerrs>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
+      if(ctx->errors>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
     }
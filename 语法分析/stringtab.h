@@ -11,6 +11,8 @@
 
 #include <assert.h>
 #include <string.h>
+#include <vector>
+#include <mutex>
 #include "list.h"    // list template
 #include "seal-io.h"
 
@@ -26,20 +28,75 @@ extern ostream& operator<<(ostream& s, Symbol sym);
 //
 /////////////////////////////////////////////////////////////////////////
 
+/////////////////////////////////////////////////////////////////////////
+//
+//  String Arena
+//
+//  A StringArena is a bump-pointer allocator for the Entrys of a string
+//  table or the characters they hold.  Memory is taken from the system
+//  in large chunks, handed out in order, and released all at once when
+//  the arena is destroyed; nothing allocated from it is freed on its own.
+//  Storage never moves, so pointers into the arena stay valid for the
+//  arena's lifetime.
+//
+/////////////////////////////////////////////////////////////////////////
+
+class StringArena {
+private:
+  struct Chunk { Chunk *next; };  // header at the start of each chunk
+  Chunk *chunks;   // every chunk obtained, newest first
+  char *next;      // next free byte of the newest chunk
+  char *limit;     // end of the newest chunk
+  size_t reserved; // bytes obtained from the system
+  size_t used;     // bytes handed out
+  size_t wasted;   // bytes lost to alignment and to retired chunk tails
+
+  StringArena(const StringArena &);             // not copyable
+  StringArena &operator =(const StringArena &);
+  void new_chunk(size_t size);
+public:
+  StringArena();
+  ~StringArena();
+
+  // size bytes aligned to align, which must be a power of two
+  void *allocate(size_t size, size_t align);
+
+  // a NUL terminated copy of the first len characters of s
+  char *copy_string(const char *s, int len);
+
+  size_t bytes_reserved() const { return reserved; }
+  size_t bytes_used() const     { return used; }
+  size_t bytes_wasted() const   { return wasted; }
+
+  // reserved bytes that can no longer be handed out, in percent
+  double fragmentation() const;
+
+  void print_stats(ostream& s, const char *name) const;
+};
+
 class Entry {
 protected:
   char *str;     // the string
   int  len;      // the length of the string (without trailing \0)
   int index;     // a unique index for each string
+  unsigned hash; // hash of str, cached for the string table's index
 public:
+  // s is not copied: it must be NUL terminated at l and live as long as
+  // the Entry.  String tables pass storage from their StringArena.
   Entry(char *s, int l, int i);
 
+  // hash of the first len characters of s
+  static unsigned hash_string(const char *s, int len);
+
   // is string argument equal to the str of this Entry?
   int equal_string(char *s, int len) const;  
                          
   // is the integer argument equal to the index of this Entry?
   bool equal_index(int ind) const           { return ind == index; }
 
+  unsigned get_hash() const                 { return hash; }
+  int get_index() const                     { return index; }
+
   ostream& print(ostream& s) const;
 
   // Return the str and len components of the Entry.
@@ -100,10 +157,20 @@ template <class Elem>
 class StringTable
 {
 protected:
-   List<Elem> *tbl;   // a string table is a list
-   int index;         // the current index
+   StringArena entry_arena;      // storage for the entries, packed
+   StringArena string_arena;     // storage for their strings, packed
+   std::vector<Elem *> tbl;      // the entries, in index order
+   std::vector<Elem *> buckets;  // open-addressed hash index over tbl
+   int index;                    // the current index
+   std::mutex lock;              // held while the table is read or grown
+
+   // find the bucket holding s, or the empty bucket where it belongs
+   int find_bucket(char *s, int len, unsigned hash);
+   void grow();
 public:
-   StringTable(): tbl((List<Elem> *) NULL), index(0) { }   // an empty table
+   StringTable(): index(0) { }   // an empty table
+   // The tables are shared by every thread, so that a Symbol is the same
+   // pointer whichever thread entered it; the methods below lock the table.
    // The following methods each add a string to the string table.  
    // Only one copy of each string is maintained.  
    // Returns a pointer to the string table entry with the string.
@@ -128,6 +195,8 @@ public:
 
    void print();  // print the entire table; for debugging
 
+   // report the memory held by the table's arenas
+   void print_stats(ostream& s, const char *name) const;
 };
 
 class IdTable : public StringTable<IdEntry> { };
@@ -154,4 +223,7 @@ extern IdTable idtable;
 extern IntTable inttable;
 extern StrTable stringtable;
 extern FloatTable floattable;
+
+// print_stats for each of the tables above
+void print_stringtab_stats(ostream& s);
 #endif
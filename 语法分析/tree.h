@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////////
  
 
+#include <vector>
 #include "stringtab.h"
 #include "seal-io.h"
 
@@ -47,6 +48,9 @@
 //           sets the line number and type of "this" to the values in
 //           the argument tree_node.  Returns "this".
 //
+//   Tree nodes are allocated from ast_arena (see AstArena below);
+//   deleting a single node does not free anything.
+//
 //
 ////////////////////////////////////////////////////////////////////////////
 class tree_node {
@@ -59,8 +63,46 @@ public:
     virtual void dump(ostream& stream, int n) = 0;
     int get_line_number();
     tree_node *set(tree_node *);
+    void shift_line_number(int lines);  // the source moved by lines
+
+    static void *operator new(size_t size);
+    static void operator delete(void *) { }
 };
 
+///////////////////////////////////////////////////////////////////
+//
+//  AstArena
+//
+//   The nodes of one compilation are bump-allocated from an AstArena
+//   and freed together: release() runs the destructors of all nodes
+//   allocated so far and returns their memory in one go, as does
+//   deleting the arena.  ast_arena is the arena new nodes come from;
+//   each thread has its own.
+//
+//   print_stats reports how many nodes of each class were allocated
+//   and the bytes they use.
+//
+///////////////////////////////////////////////////////////////////
+class AstArena {
+private:
+    struct Node { tree_node *node; size_t size; };
+    StringArena *arena;
+    std::vector<Node> nodes;    // every node allocated, oldest first
+
+    AstArena(const AstArena &);             // not copyable
+    AstArena &operator =(const AstArena &);
+public:
+    AstArena();
+    ~AstArena();
+    void *allocate(size_t size);
+    int node_count() const { return nodes.size(); }
+    tree_node *nth_node(int i) const { return nodes[i].node; }
+    void release();
+    void print_stats(ostream& s) const;
+};
+
+extern thread_local AstArena *ast_arena;
+
 ///////////////////////////////////////////////////////////////////
 //
 //  Lists of APS objects are implemented by the "list_node"
@@ -89,7 +131,13 @@ public:
 //     for(int i = l->first(); l->more(i); i = l->next(i))
 //         ... operate on l->nth(i) ...
 //
-//      
+//     iterator begin();
+//     iterator end();
+//       The same traversal with a range-based for loop:
+//
+//     for(Elem e : *l)
+//         ... operate on e ...
+//
 //     int len()
 //     returns the length of the list
 //
@@ -98,6 +146,25 @@ public:
 //     "len" is set to the length of the list.  This method is used internally
 //     by the APS package to efficiently traverse the list representation.  
 //
+//     nth, len and nth_length take constant time.  An append_node flattens
+//     the elements of its whole subtree into a vector the first time one
+//     of them is asked for, and answers from that vector afterwards.
+//     Lists are never modified once they are part of a flattened list, so
+//     the vector stays valid; see add, below.
+//
+//     list_node<Elem> *add(Elem e);
+//     returns the list with e appended.  A vector_list_node keeps its
+//     elements in a growable vector and adds e to it in place, in
+//     amortized constant time; the other lists return a new
+//     vector_list_node of their elements followed by e.  So a list built
+//     up by add, as the parser's left-recursive list rules build theirs,
+//     is one flat vector rather than a chain of append_nodes.  Since the
+//     list is changed in place, only the code building a list may add to
+//     it, and only to the list add last returned.  Once an append_node
+//     has flattened a vector_list_node, the vector is frozen: add then
+//     returns a new list, as for the other lists, so that the append_node
+//     still holds what the list held.
+//
 //     static list_node<Elem> *nil();
 //     static list_node<Elem> *single(Elem);
 //     static list_node<Elem> *append(list_node<Elem> *, list_node<Elem> *);
@@ -123,14 +190,34 @@ public:
     int next(int n)  { return n + 1; }
     int more(int n)  { return (n < len()); }
 
+    class iterator {
+        list_node<Elem> *list;
+        int n;
+    public:
+        iterator(list_node<Elem> *l, int i) : list(l), n(i) { }
+        Elem operator*() const   { return list->nth(n); }
+        iterator &operator++()   { n++; return *this; }
+        bool operator!=(const iterator &i) const { return n != i.n; }
+    };
+    iterator begin() { return iterator(this, 0); }
+    iterator end()   { return iterator(this, len()); }
+
     virtual list_node<Elem> *copy_list() = 0;
     virtual ~list_node() { }
     virtual int len() = 0;
     virtual Elem nth_length(int n, int &len) = 0;
 
+    // Add the elements of this list to the end of "out".  Sublists that
+    // still have to be expanded are pushed on "pending" instead, so that
+    // deep append trees are flattened without recursion.
+    virtual void flatten_into(std::vector<Elem> &out,
+                              std::vector<list_node<Elem> *> &pending) = 0;
+
     static list_node<Elem> *nil();
     static list_node<Elem> *single(Elem);
     static list_node<Elem> *append(list_node<Elem> *l1,list_node<Elem> *l2);
+
+    virtual list_node<Elem> *add(Elem e);
 };
 
 char *pad(int n);
@@ -142,6 +229,7 @@ public:
     list_node<Elem> *copy_list();
     int len();
     Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &, std::vector<list_node<Elem> *> &) { }
     void dump(ostream& stream, int n);
 };
 
@@ -154,6 +242,8 @@ public:
     list_node<Elem> *copy_list();
     int len();
     Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &)
+        { out.push_back(elem); }
     void dump(ostream& stream, int n);
 };
 
@@ -161,15 +251,37 @@ public:
 template <class Elem> class append_node : public list_node<Elem> {
 private:
     list_node<Elem> *some, *rest;
+    std::vector<Elem> *flat;    // all elements, built on first use
+    std::vector<Elem> &elems();
 public:
     append_node(list_node<Elem> *l1, list_node<Elem> *l2) {
 	some = l1;
 	rest = l2;
+	flat = NULL;
     }
+    ~append_node() { delete flat; }
+    list_node<Elem> *copy_list();
+    int len();
+    Elem nth(int n);
+    Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &pending);
+    void dump(ostream& stream, int n);
+};
+
+
+template <class Elem> class vector_list_node : public list_node<Elem> {
+private:
+    std::vector<Elem> elems;
+    bool frozen;                // flattened into an append_node
+public:
+    vector_list_node() { frozen = false; }
     list_node<Elem> *copy_list();
     int len();
     Elem nth(int n);
     Elem nth_length(int n, int &len);
+    void flatten_into(std::vector<Elem> &out, std::vector<list_node<Elem> *> &)
+        { frozen = true; out.insert(out.end(), elems.begin(), elems.end()); }
+    list_node<Elem> *add(Elem e);
     void dump(ostream& stream, int n);
 };
 
@@ -207,6 +319,36 @@ template <class Elem> Elem list_node<Elem>::nth(int n)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////
+//
+// list_node::add
+//
+// return a vector_list_node of the elements of the list followed by e
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *list_node<Elem>::add(Elem e)
+{
+    list_node<Elem> *l = new vector_list_node<Elem>();
+    for (int i = 0; i < len(); i++)
+	l->add(nth(i));
+    return l->add(e);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::add
+//
+// append e in place, or to a copy once the list is frozen
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::add(Elem e)
+{
+    if (frozen)
+	return list_node<Elem>::add(e);
+    elems.push_back(e);
+    return this;
+}
+
 // added 10/30/06 cgs
 template <class Elem> Elem append_node<Elem>::nth(int n)
 {
@@ -353,7 +495,7 @@ template <class Elem> list_node<Elem> *append_node<Elem>::copy_list()
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> int append_node<Elem>::len()
 {
-    return some->len() + rest->len();
+    return elems().size();
 }
 
 
@@ -366,14 +508,58 @@ template <class Elem> int append_node<Elem>::len()
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> Elem append_node<Elem>::nth_length(int n, int &len)
 {
-    int rlen;
-    Elem tmp = some->nth_length(n, len);
+    std::vector<Elem> &v = elems();
+
+    len = v.size();
+    if (n < 0 || n >= len)
+	return NULL;
+    return v[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::elems
+//
+// return the elements of the append_node, flattening it the first time
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> std::vector<Elem> &append_node<Elem>::elems()
+{
+    if (!flat) {
+	std::vector<list_node<Elem> *> pending;
+	flat = new std::vector<Elem>();
+	pending.push_back(this);
+	while (!pending.empty()) {
+	    list_node<Elem> *l = pending.back();
+	    pending.pop_back();
+	    if (l == this) {
+		pending.push_back(rest);
+		pending.push_back(some);
+	    } else
+		l->flatten_into(*flat, pending);
+	}
+    }
+    return *flat;
+}
 
-    if (!tmp) {
-	tmp = rest->nth_length(n-len, rlen);
-	len += rlen;
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::flatten_into
+//
+// add the elements of the append_node to a flattening in progress
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void append_node<Elem>::flatten_into(std::vector<Elem> &out,
+                                                           std::vector<list_node<Elem> *> &pending)
+{
+    if (flat)
+	out.insert(out.end(), flat->begin(), flat->end());
+    else {
+	pending.push_back(rest);
+	pending.push_back(some);
     }
-    return tmp;
 }
 
 
@@ -396,6 +582,92 @@ template <class Elem> void append_node<Elem>::dump(ostream& stream, int n)
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::copy_list
+//
+// return the deep copy of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> list_node<Elem> *vector_list_node<Elem>::copy_list()
+{
+    vector_list_node<Elem> *l = new vector_list_node<Elem>();
+    l->elems.reserve(elems.size());
+    for (size_t i = 0; i < elems.size(); i++)
+	l->elems.push_back((Elem) elems[i]->copy());
+    return l;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::len
+//
+// return the length of the vector_list_node
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int vector_list_node<Elem>::len()
+{
+    return elems.size();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::nth
+//
+// return the nth element, without the virtual call to nth_length
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem vector_list_node<Elem>::nth(int n)
+{
+    if (n < 0 || n >= (int) elems.size()) {
+	cerr << "error: outside the range of the list\n";
+	exit(1);
+    }
+    return elems[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::nth_length
+//
+// return the nth element on the list
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> Elem vector_list_node<Elem>::nth_length(int n, int &len)
+{
+    len = elems.size();
+    if (n < 0 || n >= len)
+	return NULL;
+    return elems[n];
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// vector_list_node::dump
+//
+// dump for list node, the same as for the single_list_node or the
+// append_nodes holding the same elements
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> void vector_list_node<Elem>::dump(ostream& stream, int n)
+{
+    if (elems.empty())
+	stream << pad(n) << "(nil)\n";
+    else if (elems.size() == 1)
+	elems[0]->dump(stream, n);
+    else {
+	stream << pad(n) << "list\n";
+	for (size_t i = 0; i < elems.size(); i++)
+	    elems[i]->dump(stream, n+2);
+	stream << pad(n) << "(end_of_list)\n";
+    }
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // list
@@ -124,7 +124,7 @@ char *seal_token_to_string(int tok)
   }
 }
 
-void print_seal_token(int tok)
+void print_seal_token(int tok, YYSTYPE value)
 {
 
   cerr << seal_token_to_string(tok);
@@ -133,42 +133,42 @@ void print_seal_token(int tok)
   case (CONST_STRING):
     cerr << " = ";
     cerr << " \"";
-    print_escaped_string(cerr, seal_yylval.symbol->get_string());
+    print_escaped_string(cerr, value.symbol->get_string());
     cerr << "\"";
 #ifdef CHECK_TABLES
-    stringtable.lookup_string(seal_yylval.symbol->get_string());
+    stringtable.lookup_string(value.symbol->get_string());
 #endif
     break;
   case (CONST_INT):
-    cerr << " = " << seal_yylval.symbol;
+    cerr << " = " << value.symbol;
 #ifdef CHECK_TABLES
-    inttable.lookup_string(seal_yylval.symbol->get_string());
+    inttable.lookup_string(value.symbol->get_string());
 #endif
     break;
   case (CONST_FLOAT):
-    cerr << " = " << seal_yylval.symbol;
+    cerr << " = " << value.symbol;
 #ifdef CHECK_TABLES
-    floattable.lookup_string(seal_yylval.symbol->get_string());
+    floattable.lookup_string(value.symbol->get_string());
 #endif
     break;
   case (CONST_BOOL):
-    cerr << (seal_yylval.boolean ? " = true" : " = false");
+    cerr << (value.boolean ? " = true" : " = false");
     break;
   case (OBJECTID):
-    cerr << " = " << seal_yylval.symbol;
+    cerr << " = " << value.symbol;
 #ifdef CHECK_TABLES
-    idtable.lookup_string(seal_yylval.symbol->get_string());
+    idtable.lookup_string(value.symbol->get_string());
 #endif
     break;
   case (TYPEID):
-    cerr << " = " << seal_yylval.symbol;
+    cerr << " = " << value.symbol;
 #ifdef CHECK_TABLES
-    idtable.lookup_string(seal_yylval.symbol->get_string());
+    idtable.lookup_string(value.symbol->get_string());
 #endif
     break;
   case (ERROR): 
     cerr << " = ";
-    print_escaped_string(cerr, seal_yylval.error_msg);
+    print_escaped_string(cerr, value.error_msg);
     break;
   }
 }
@@ -181,37 +181,37 @@ void dump_seal_token(ostream& out, int lineno, int token, YYSTYPE yylval)
     switch (token) {
     case (CONST_STRING):
 	out << " \"";
-	print_escaped_string(out, seal_yylval.symbol->get_string());
+	print_escaped_string(out, yylval.symbol->get_string());
 	out << "\"";
 #ifdef CHECK_TABLES
-	stringtable.lookup_string(seal_yylval.symbol->get_string());
+	stringtable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (CONST_INT):
-	out << " " << seal_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	inttable.lookup_string(seal_yylval.symbol->get_string());
+	inttable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (CONST_FLOAT):
-	out << " " << seal_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	floattable.lookup_string(seal_yylval.symbol->get_string());
+	floattable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (CONST_BOOL):
-	out << (seal_yylval.boolean ? " true" : " false");
+	out << (yylval.boolean ? " true" : " false");
 	break;
     case (OBJECTID):
-	out << " " << seal_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	idtable.lookup_string(seal_yylval.symbol->get_string());
+	idtable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (TYPEID):
-	out << " " << seal_yylval.symbol;
+	out << " " << yylval.symbol;
 #ifdef CHECK_TABLES
-	idtable.lookup_string(seal_yylval.symbol->get_string());
+	idtable.lookup_string(yylval.symbol->get_string());
 #endif
 	break;
     case (ERROR): 
@@ -220,12 +220,12 @@ void dump_seal_token(ostream& out, int lineno, int token, YYSTYPE yylval)
         // if we see an "empty" string here, we can safely assume the
         // lexer is reporting an occurrance of an illegal NUL in the
         // input stream
-        if (seal_yylval.error_msg[0] == 0) {
+        if (yylval.error_msg[0] == 0) {
           out << " \"\\000\"";
         }
         else {
           out << " \"";
-          print_escaped_string(out, seal_yylval.error_msg);
+          print_escaped_string(out, yylval.error_msg);
           out << "\"";
           break;
         }
@@ -240,8 +240,6 @@ char *strdup(const char *s)
 {
   char *news;
 
-  if (s == NULL) return(NULL);
-
   news = (char *)malloc(strlen(s)+1);
   strcpy(news, s);
   return(news);
@@ -10,8 +10,10 @@
 
 #include "seal-io.h"
 
+union YYSTYPE;  // seal-parse.h
+
 extern char *seal_token_to_string(int tok);
-extern void print_seal_token(int tok);
+extern void print_seal_token(int tok, YYSTYPE value);
 extern void fatal_error(char *);
 extern void print_escaped_string(ostream& str, const char *s);
 extern char *pad(int);